@@ -54,6 +54,10 @@ echo "$(basename $OUT_PATH)"
 copyFiles "" 0
 cd "$ORIG_PATH"
 
+# generate shared limits module (engine header is the single source for the dashboard and API)
+echo "Generating shared limits..."
+sed -n 's/^#define \(MAX_[A-Z_]*\|NUM_[A-Z_]*\|SPM_[A-Z_]*\) \([0-9]*\).*/export const \1 = \2;/p' ./src/public/webasm/spmlimits.h > ./dist/public/scripts/limits.mjs
+
 # run emscripten
 cd ./emsdk
 git pull
@@ -61,4 +65,13 @@ git pull
 ./emsdk activate latest
 source ./emsdk_env.sh
 cd ..
-emcc -o ./dist/public/webasm/procmgr.js ./src/public/webasm/procmgr.c ./src/public/webasm/proclist.c -sDEFAULT_LIBRARY_FUNCS_TO_INCLUDE=\$stringToNewUTF8,\$UTF8ToString -sEXPORTED_FUNCTIONS=_getFrames,_free -sNO_EXIT_RUNTIME=1 -sEXPORTED_RUNTIME_METHODS=ccall,cwrap
+
+# dashboard engine module (loaded by the simulation worker, see engine-worker.mjs; memory is shared so the page can submit live processes through the ring in it)
+emcc -o ./dist/public/webasm/procmgr.mjs ./src/public/webasm/procmgr.c ./src/public/webasm/proclist.c ./src/public/webasm/proccheck.c ./src/public/webasm/procgen.c ./src/public/webasm/procheap.c ./src/public/webasm/proclevels.c ./src/public/webasm/procpool.c ./src/public/webasm/procresim.c ./src/public/webasm/procring.c ./src/public/webasm/procrunq.c ./src/public/webasm/procset.c ./src/public/webasm/procsim.c ./src/public/webasm/procstats.c ./src/public/webasm/framebuf.c ./src/public/webasm/intervalbuf.c -msimd128 -sDEFAULT_LIBRARY_FUNCS_TO_INCLUDE=\$stringToNewUTF8,\$UTF8ToString -sEXPORTED_FUNCTIONS=_getFrames,_getFrameData,_freeFrameData,_getMetrics,_spmCreate,_spmCreateLive,_spmGetRing,_spmPoll,_spmStep,_spmReadFrame,_spmDestroy,_getFrameDataFromArray,_getMetricsFromArray,_getGeneratedIntervalData,_getGeneratedMetrics,_spmSessionCreate,_spmSessionRun,_spmSessionRunArray,_spmSessionDestroy,_getIntervalData,_getIntervalDataFromArray,_freeIntervalData,_spmGetStats,_spmGetError,_malloc,_free -sENVIRONMENT=worker -sSHARED_MEMORY=1 -sMODULARIZE=1 -sEXPORT_ES6=1 -sEXPORT_NAME=createEngineModule -sNO_EXIT_RUNTIME=1 -sALLOW_MEMORY_GROWTH=1 -sMAXIMUM_MEMORY=4GB -sEXPORTED_RUNTIME_METHODS=ccall,cwrap,HEAPU32,HEAPF64,wasmMemory
+
+# parameter sweep module (loaded by the sweep worker, see sweep-worker.mjs; threads share memory through SharedArrayBuffer, so pages must be cross-origin isolated; see index.mts)
+emcc -o ./dist/public/webasm/procsweep.mjs ./src/public/webasm/procsweep.c ./src/public/webasm/procmgr.c ./src/public/webasm/proclist.c ./src/public/webasm/proccheck.c ./src/public/webasm/procgen.c ./src/public/webasm/procheap.c ./src/public/webasm/proclevels.c ./src/public/webasm/procpool.c ./src/public/webasm/procrunq.c ./src/public/webasm/procset.c ./src/public/webasm/procstats.c ./src/public/webasm/framebuf.c ./src/public/webasm/intervalbuf.c -msimd128 -pthread -sPTHREAD_POOL_SIZE=navigator.hardwareConcurrency -sMODULARIZE=1 -sEXPORT_ES6=1 -sEXPORT_NAME=createSweepModule -sENVIRONMENT=worker -sEXPORTED_FUNCTIONS=_getSweep,_spmGetError,_free -sEXPORTED_RUNTIME_METHODS=stringToNewUTF8,wasmMemory -sALLOW_MEMORY_GROWTH=1 -sMAXIMUM_MEMORY=4GB
+
+# server engine module (one instance per worker thread in sim-pool.mts; optimized since the API runs it on request)
+mkdir -p ./dist/webasm
+emcc -o ./dist/webasm/procnode.mjs ./src/public/webasm/procmgr.c ./src/public/webasm/proclist.c ./src/public/webasm/proccheck.c ./src/public/webasm/procgen.c ./src/public/webasm/procheap.c ./src/public/webasm/proclevels.c ./src/public/webasm/procpool.c ./src/public/webasm/procrunq.c ./src/public/webasm/procset.c ./src/public/webasm/procstats.c ./src/public/webasm/framebuf.c ./src/public/webasm/intervalbuf.c -O3 -msimd128 -sENVIRONMENT=node -sMODULARIZE=1 -sEXPORT_ES6=1 -sEXPORT_NAME=createEngineModule -sEXPORTED_FUNCTIONS=_getFrameData,_freeFrameData,_getIntervalData,_freeIntervalData,_getMetrics,_spmGetError,_free -sEXPORTED_RUNTIME_METHODS=stringToNewUTF8,HEAPU32,HEAPF64 -sALLOW_MEMORY_GROWTH=1 -sMAXIMUM_MEMORY=4GB
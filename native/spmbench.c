@@ -0,0 +1,251 @@
+// Benchmark suite for the scheduler engine.
+// Runs every algorithm over seeded synthetic workloads of increasing size and CPU count and writes one JSON record per run.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "procmgr.h"
+#include "procgen.h"
+
+#ifdef SPM_BENCH_WRAP_MALLOC
+#include <malloc.h>
+#endif
+
+// workload arrival and duration distributions
+enum Distributions {
+    DIST_UNIFORM, // uniform arrivals, uniform durations
+    DIST_BURSTY,  // arrivals in bursts, uniform durations
+    DIST_HEAVY,   // uniform arrivals, pareto (heavy tailed) durations
+    NUM_DISTS
+};
+
+const char* algNames[NUM_ALGS] = { "FIFO", "LIFO", "RR", "SJF", "LJF", "SRTF", "MLFQ" };
+const char* distNames[NUM_DISTS] = { "uniform", "bursty", "heavy" };
+const char* queueNames[2] = { "global", "percpu" }; // one queue for all CPUs, or one per CPU with work stealing
+
+
+
+/**************************************************/
+/* Allocation Tracking                            */
+/**************************************************/
+
+// counters (only maintained when linked with --wrap for the allocator functions)
+unsigned long long allocCount = 0;
+unsigned long long liveBytes = 0;
+unsigned long long peakBytes = 0;
+
+#ifdef SPM_BENCH_WRAP_MALLOC
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+// adds allocated block to live bytes
+void trackAlloc(void* ptr) {
+
+    if (ptr == NULL) return;
+    allocCount++;
+    liveBytes += malloc_usable_size(ptr);
+    if (liveBytes > peakBytes) peakBytes = liveBytes;
+}
+
+void* __wrap_malloc(size_t size) {
+
+    void* ptr = __real_malloc(size);
+    trackAlloc(ptr);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t num, size_t size) {
+
+    void* ptr = __real_calloc(num, size);
+    trackAlloc(ptr);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+
+    size_t oldSize = ptr != NULL ? malloc_usable_size(ptr) : 0;
+    void* newPtr = __real_realloc(ptr, size);
+    if (newPtr != NULL) {
+        liveBytes -= oldSize;
+        trackAlloc(newPtr);
+    }
+    return newPtr;
+}
+
+void __wrap_free(void* ptr) {
+
+    if (ptr != NULL) liveBytes -= malloc_usable_size(ptr);
+    __real_free(ptr);
+}
+
+#endif
+
+// resets counters (peak starts from what is currently live)
+void resetAllocTracking() {
+
+    allocCount = 0;
+    peakBytes = liveBytes;
+}
+
+
+
+/**************************************************/
+/* Workload Generation                            */
+/**************************************************/
+
+// fills unstarted with processes in start time order (see procgen.h), sized so the CPUs are about 90% utilized; durations average 3
+int generateWorkload(ProcessManager* procMgr, unsigned int numProcesses, enum Distributions dist, unsigned long long seed) {
+
+    GenParams params = { .numProcesses = numProcesses, .arrivals = dist == DIST_BURSTY ? ARRIVAL_BURSTY : ARRIVAL_POISSON,
+        .durations = dist == DIST_HEAVY ? DURATION_PARETO : DURATION_UNIFORM, .meanDuration = 3, .utilization = 90, .burstSize = 64,
+        .seedLow = (unsigned int)seed, .seedHigh = (unsigned int)(seed >> 32) };
+    return generateProcesses(&procMgr->unstarted, procMgr->numCpus, &params);
+}
+
+
+
+/**************************************************/
+/* Runner                                         */
+/**************************************************/
+
+double getSeconds() {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// runs one configuration and writes its JSON record; returns 0 on success
+int runBenchmark(FILE* out, enum Algorithms alg, enum Distributions dist, unsigned int numProcesses, unsigned int numCpus, unsigned int rrQuantum, unsigned long long seed, int withFrames, int isPerCpu, int* first) {
+
+    // build workload
+    resetAllocTracking();
+    unsigned long long baseBytes = liveBytes;
+    ProcessManager* procMgr = createProcessManager(numCpus, alg, rrQuantum);
+    if (procMgr == NULL || generateWorkload(procMgr, numProcesses, dist, seed)) {
+        fputs("Could not allocate workload\n", stderr);
+        if (procMgr != NULL) freeProcessManager(procMgr);
+        return 1;
+    }
+
+    // sort (already in start time order, so this measures the best case)
+    double sortStart = getSeconds();
+    if (sortProcessList(&procMgr->unstarted)) {
+        freeProcessManager(procMgr);
+        return 1;
+    }
+    double sortSeconds = getSeconds() - sortStart;
+
+    // attach binary frames and per-CPU run queues if requested
+    if ((withFrames && (procMgr->frameBuf = createFrameBuffer(numCpus)) == NULL) || (isPerCpu && usePerCpuQueues(procMgr))) {
+        freeFrameBuffer(procMgr->frameBuf);
+        freeProcessManager(procMgr);
+        return 1;
+    }
+
+    // run
+    unsigned long long setupAllocs = allocCount;
+    double runStart = getSeconds();
+    runAlgorithm(procMgr);
+    double runSeconds = getSeconds() - runStart;
+    unsigned long long runAllocs = allocCount - setupAllocs;
+
+    // write record (ticks are simulated seconds, decisions are dispatches, steals are dispatches from another CPU's queue)
+    unsigned long long ticks = procMgr->time + 1;
+    unsigned long long decisions = procMgr->numDecisions;
+    unsigned long long steals = procMgr->runQueues != NULL ? procMgr->runQueues->numSteals : 0;
+    EngineStats engineStats = collectEngineStats(procMgr);
+    fprintf(out, "%s  {\"alg\": \"%s\", \"dist\": \"%s\", \"processes\": %u, \"cpus\": %u, \"quantum\": %u, \"seed\": %llu, \"frames\": %s, \"queues\": \"%s\", "
+        "\"ok\": %s, \"simTicks\": %llu, \"decisions\": %llu, \"steals\": %llu, \"sortSeconds\": %.9f, \"runSeconds\": %.9f, "
+        "\"nsPerTick\": %.3f, \"nsPerDecision\": %.3f, \"peakBytes\": %llu, \"allocs\": %llu, "
+        "\"events\": %.0f, \"nodeMoves\": %.0f, \"queueScans\": %.0f, \"framesEmitted\": %.0f, "
+        "\"arrivalSeconds\": %.9f, \"tickSeconds\": %.9f, \"dispatchSeconds\": %.9f, \"frameSeconds\": %.9f}",
+        *first ? "" : ",\n", algNames[alg], distNames[dist], numProcesses, numCpus, rrQuantum, seed, withFrames ? "true" : "false", queueNames[isPerCpu],
+        procMgr->errFlag ? "false" : "true", ticks, decisions, steals, sortSeconds, runSeconds,
+        runSeconds * 1e9 / ticks, decisions ? runSeconds * 1e9 / decisions : 0.0, peakBytes - baseBytes, runAllocs,
+        engineStats.events, engineStats.nodeMoves, engineStats.queueScans, engineStats.framesEmitted,
+        engineStats.arrivalSeconds, engineStats.tickSeconds, engineStats.dispatchSeconds, engineStats.frameSeconds);
+    fflush(out);
+    *first = 0;
+
+    // free
+    freeFrameBuffer(procMgr->frameBuf);
+    freeProcessManager(procMgr);
+    return 0;
+}
+
+void printUsage(char* name) {
+
+    fprintf(stderr, "usage: %s [-n max_processes] [-c max_cpus] [-q quantum] [-s seed] [-a alg] [-d dist] [-Q global|percpu|both] [-F] [-o out.json]\n", name);
+    fputs("  sizes run in powers of 10 from 100 up to max_processes (default 100000, up to 10000000)\n", stderr);
+    fputs("  cpu counts run in powers of 4 from 1 up to max_cpus (default 64)\n", stderr);
+    fputs("  -a / -d restrict to one algorithm (FIFO, LIFO, RR, SJF, LJF, SRTF, MLFQ) / distribution (uniform, bursty, heavy)\n", stderr);
+    fputs("  -Q runs one global queue (default), per-CPU run queues with work stealing, or both for comparison\n", stderr);
+    fputs("  -F also writes binary frames (bounded by the frame output limit)\n", stderr);
+}
+
+int main(int argc, char** argv) {
+
+    // defaults
+    unsigned long long maxProcesses = 100000, maxCpus = 64, rrQuantum = 4, seed = 1;
+    int onlyAlg = -1, onlyDist = -1, withFrames = 0, minQueues = 0, maxQueues = 0;
+    FILE* out = stdout;
+
+    // parse options
+    int opt;
+    while ((opt = getopt(argc, argv, "n:c:q:s:a:d:Q:Fo:h")) != -1) {
+        switch (opt) {
+            case 'n': maxProcesses = strtoull(optarg, NULL, 10); break;
+            case 'c': maxCpus = strtoull(optarg, NULL, 10); break;
+            case 'q': rrQuantum = strtoull(optarg, NULL, 10); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            case 'F': withFrames = 1; break;
+            case 'a':
+                for (int i = 0; i < NUM_ALGS; i++)
+                    if (strcmp(optarg, algNames[i]) == 0) onlyAlg = i;
+                if (onlyAlg < 0) { printUsage(argv[0]); return 2; }
+                break;
+            case 'd':
+                for (int i = 0; i < NUM_DISTS; i++)
+                    if (strcmp(optarg, distNames[i]) == 0) onlyDist = i;
+                if (onlyDist < 0) { printUsage(argv[0]); return 2; }
+                break;
+            case 'Q':
+                if (strcmp(optarg, "global") == 0) minQueues = maxQueues = 0;
+                else if (strcmp(optarg, "percpu") == 0) minQueues = maxQueues = 1;
+                else if (strcmp(optarg, "both") == 0) { minQueues = 0; maxQueues = 1; }
+                else { printUsage(argv[0]); return 2; }
+                break;
+            case 'o':
+                if ((out = fopen(optarg, "w")) == NULL) { perror(optarg); return 1; }
+                break;
+            default:
+                printUsage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (maxProcesses < 100 || maxProcesses > MAX_PROCESSES || maxCpus < 1 || maxCpus > MAX_NUM_CPUS || rrQuantum < 1 || rrQuantum > MAX_TIME_AND_PID) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // run every configuration
+    int first = 1, status = 0;
+    fputs("[\n", out);
+    for (unsigned long long numProcesses = 100; numProcesses <= maxProcesses; numProcesses *= 10)
+        for (unsigned long long numCpus = 1; numCpus <= maxCpus; numCpus *= 4)
+            for (int dist = 0; dist < NUM_DISTS; dist++)
+                for (int alg = 0; alg < NUM_ALGS; alg++)
+                    for (int isPerCpu = minQueues; isPerCpu <= maxQueues; isPerCpu++)
+                        if ((onlyAlg < 0 || alg == onlyAlg) && (onlyDist < 0 || dist == onlyDist))
+                            status |= runBenchmark(out, alg, dist, numProcesses, numCpus, rrQuantum, seed, withFrames, isPerCpu, &first);
+    fputs("\n]\n", out);
+
+    if (out != stdout) fclose(out);
+    return status;
+}
@@ -0,0 +1,517 @@
+// Command line front end for the scheduler engine.
+// Reads a workload in the dashboard format (numCpus,alg,quantum,pid,start,duration,...) from a file or stdin and writes frames to stdout.
+// Large workloads can be read from a trace file instead (see proctrace.h), streamed into the simulation as it reaches them.
+// A trace can also be replayed live: a producer thread submits its records through a ring (see procring.h) while the simulation steps.
+// Synthetic workloads are generated inside the engine from a seed (see procgen.h), so stress runs need no input file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include "procmgr.h"
+#include "procgen.h"
+#include "procsim.h"
+#include "procsweep.h"
+#include "proctrace.h"
+
+// entries in the live replay ring
+#define LIVE_RING_CAPACITY 4096
+
+// generator settings not given on the command line
+#define GEN_MEAN_DURATION 3
+#define GEN_UTILIZATION 90
+#define GEN_BURST_SIZE 64
+
+// output formats
+enum OutputFormats {
+    OUTPUT_TEXT,   // same text frames as getFrames
+    OUTPUT_BINARY, // raw frame buffer words (see framebuf.h)
+    OUTPUT_NONE,   // simulate only (for profiling)
+    OUTPUT_METRICS,  // scheduling statistics only (no frames)
+    OUTPUT_INTERVALS // execution intervals and queue length changes (see intervalbuf.h)
+};
+
+void printUsage(char* name) {
+
+    fprintf(stderr, "usage: %s [-f text|binary|none|metrics|intervals] [-p] [-e] [-s minCpus,maxCpus,minQuantum,maxQuantum [-j threads]] [workload_file]\n", name);
+    fprintf(stderr, "       %s -t numCpus,alg,quantum [-u] [options above] trace_file\n", name);
+    fprintf(stderr, "       %s -t numCpus,alg,quantum -l [-f text|binary|none] [-e] trace_file\n", name);
+    fprintf(stderr, "       %s -g numCpus,alg,quantum,numProcesses,seed[,poisson|bursty[,exponential|uniform|pareto]] [options above]\n", name);
+    fputs("  reads stdin if no workload file is given; whitespace (e.g. one process per line) is ignored\n", stderr);
+    fputs("  -t reads processes from a CSV (pid,start,duration per line) or binary trace, streamed in start time order\n", stderr);
+    fputs("  -u reads the whole trace before running and sorts it (for traces not in start time order)\n", stderr);
+    fputs("  -g generates a seeded synthetic workload (mean duration 3, 90% utilization, bursts of 64) instead of reading one\n", stderr);
+    fputs("  -l replays the trace live: another thread submits its records through a lock-free ring while the simulation steps\n", stderr);
+    fputs("  -f intervals writes one 'cpu pid start end remaining' line per execution interval, then one 'time queue_size' line per queue length change\n", stderr);
+    fputs("  -p gives every CPU its own run queue (idle CPUs steal work) instead of one global queue\n", stderr);
+    fputs("  -e writes engine counters (and phase times in SPM_PROFILE builds) to stderr after the run\n", stderr);
+    fputs("  -s sweeps every algorithm over the CPU and quantum ranges (ignoring the workload's own settings) and writes a metrics table\n", stderr);
+}
+
+// reads whole stream into a null terminated string without whitespace; returns null on failure
+char* readWorkload(FILE* file) {
+
+    // init growable string
+    size_t len = 0, capacity = 4096;
+    char* str = malloc(capacity);
+    if (str == NULL) return NULL;
+
+    // read chunks and keep non-whitespace characters
+    char chunk[65536];
+    size_t chunkLen;
+    while ((chunkLen = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+
+        // grow (geometrically) if chunk may not fit
+        if (len + chunkLen + 1 > capacity) {
+            while (len + chunkLen + 1 > capacity)
+                capacity *= 2;
+            char* tmpStr = realloc(str, capacity);
+            if (tmpStr == NULL) {
+                free(str);
+                return NULL;
+            }
+            str = tmpStr;
+        }
+
+        // copy
+        for (size_t i = 0; i < chunkLen; i++)
+            if (!isspace((unsigned char)chunk[i]))
+                str[len++] = chunk[i];
+    }
+
+    // terminate
+    str[len] = '\0';
+    return str;
+}
+
+// writes one line summarizing a time histogram
+void printSummary(char* name, MetricSummary summary) {
+
+    printf("%s: avg %.3f p50 %.0f p90 %.0f p99 %.0f max %.0f\n", name, summary.avg, summary.p50, summary.p90, summary.p99, summary.max);
+}
+
+// writes metrics as one "name: value" line each
+void printMetrics(SimMetrics metrics) {
+
+    printf("processes: %.0f\n", metrics.numProcesses);
+    printf("makespan: %.0f\n", metrics.makespan);
+    printf("busy time: %.0f\n", metrics.busyTime);
+    printf("cpu utilization: %.4f\n", metrics.cpuUtilization);
+    printf("throughput: %.6f\n", metrics.throughput);
+    printf("context switches: %.0f\n", metrics.contextSwitches);
+    printf("preemptions: %.0f\n", metrics.preemptions);
+    printSummary("waiting time", metrics.waitingTime);
+    printSummary("turnaround time", metrics.turnaroundTime);
+    printSummary("response time", metrics.responseTime);
+}
+
+// describes why a simulation stopped (the text frame error if there is one, otherwise the engine error)
+const char* getRunError(ProcessManager* procMgr, int error) {
+
+    if (procMgr->frameStr != NULL && procMgr->frameStr[0] == 'E') return procMgr->frameStr + 1;
+    switch (error) {
+        case SPM_ERR_LIMIT:
+            return "output or simulated time over its limit (try '-f metrics' or '-f none')";
+        case SPM_ERR_INPUT:
+            return "could not read arrivals";
+        default:
+            return "out of memory";
+    }
+}
+
+// writes engine statistics to stderr (kept apart from the frames on stdout)
+void printEngineStats(EngineStats engineStats) {
+
+    fprintf(stderr, "events: %.0f\n", engineStats.events);
+    fprintf(stderr, "allocations: %.0f\n", engineStats.allocations);
+    fprintf(stderr, "node moves: %.0f\n", engineStats.nodeMoves);
+    fprintf(stderr, "queue scans: %.0f\n", engineStats.queueScans);
+    fprintf(stderr, "frames emitted: %.0f\n", engineStats.framesEmitted);
+    fprintf(stderr, "phase seconds: arrival %.6f tick %.6f dispatch %.6f frame %.6f\n",
+        engineStats.arrivalSeconds, engineStats.tickSeconds, engineStats.dispatchSeconds, engineStats.frameSeconds);
+}
+
+// writes why a trace could not be read to stderr (with the line of a malformed CSV record)
+void printTraceError(TraceReader* trace) {
+
+    if (trace->format == TRACE_CSV && (trace->error == TRACE_ERR_FORMAT || trace->error == TRACE_ERR_RANGE))
+        fprintf(stderr, "Trace failed at line %llu: %s\n", trace->lineNumber, getTraceError(trace));
+    else
+        fprintf(stderr, "Trace failed: %s\n", getTraceError(trace));
+}
+
+// writes intervals and queue length changes as space separated lines under a count header each
+void printIntervals(IntervalBuffer* intervals) {
+
+    printf("intervals: %u (cpu pid start end remaining)\n", intervals->numIntervals);
+    for (unsigned int i = 0; i < intervals->numIntervals; i++) {
+        unsigned int* interval = intervals->data + INTERVAL_WORDS * i;
+        printf("%u %u %u %u %u\n", interval[0], interval[1], interval[2], interval[3], interval[4]);
+    }
+    printf("queue: %u (time queue_size)\n", intervals->numQueuePoints);
+    for (unsigned int i = 0; i < intervals->numQueuePoints; i++)
+        printf("%u %u\n", intervals->queuePoints[QUEUE_POINT_WORDS * i], intervals->queuePoints[QUEUE_POINT_WORDS * i + 1]);
+    printf("frames: %u\n", intervals->numFrames);
+}
+
+// writes one tab separated line per sweep configuration
+void printSweep(SweepTable* table) {
+
+    puts("alg\tcpus\tquantum\tavg_wait\tp99_wait\tavg_turnaround\tp99_turnaround\tavg_response\tutilization\tthroughput\tcontext_switches");
+    for (unsigned int i = 0; i < (unsigned int)table->numRows; i++) {
+        SweepRow* row = &table->rows[i];
+        printf("%.0f\t%.0f\t%.0f\t%.3f\t%.0f\t%.3f\t%.0f\t%.3f\t%.4f\t%.6f\t%.0f\n", row->alg, row->numCpus, row->rrQuantum,
+            row->metrics.waitingTime.avg, row->metrics.waitingTime.p99, row->metrics.turnaroundTime.avg, row->metrics.turnaroundTime.p99,
+            row->metrics.responseTime.avg, row->metrics.cpuUtilization, row->metrics.throughput, row->metrics.contextSwitches);
+    }
+}
+
+// parses '-g numCpus,alg,quantum,numProcesses,seed[,arrivals[,durations]]'; returns 1 on success
+int parseGenerator(char* arg, SimConfig* config, GenParams* params) {
+
+    // numeric fields (the seed may take all 64 bits)
+    unsigned long long seed;
+    int numRead;
+    if (sscanf(arg, "%u,%u,%u,%u,%llu%n", &config->numCpus, &config->alg, &config->rrQuantum, &params->numProcesses, &seed, &numRead) != 5)
+        return 0;
+    *params = (GenParams){ .numProcesses = params->numProcesses, .arrivals = ARRIVAL_POISSON, .durations = DURATION_EXPONENTIAL,
+        .meanDuration = GEN_MEAN_DURATION, .utilization = GEN_UTILIZATION, .burstSize = GEN_BURST_SIZE,
+        .seedLow = (unsigned int)seed, .seedHigh = (unsigned int)(seed >> 32) };
+
+    // optional named arrival pattern and duration distribution
+    static const char* arrivalNames[NUM_ARRIVAL_PATTERNS] = { "poisson", "bursty" };
+    static const char* durationNames[NUM_DURATION_DISTRIBUTIONS] = { "exponential", "uniform", "pareto" };
+    char* name = arg + numRead;
+    for (int field = 0; *name != '\0'; field++) {
+        if (*name++ != ',' || field > 1) return 0;
+        size_t len = strcspn(name, ",");
+        const char** names = field == 0 ? arrivalNames : durationNames;
+        unsigned int numNames = field == 0 ? NUM_ARRIVAL_PATTERNS : NUM_DURATION_DISTRIBUTIONS;
+        unsigned int i = 0;
+        while (i < numNames && (strlen(names[i]) != len || strncmp(name, names[i], len) != 0)) i++;
+        if (i == numNames) return 0;
+        if (field == 0) params->arrivals = i;
+        else params->durations = i;
+        name += len;
+    }
+    return 1;
+}
+
+// creates a process manager fed from a trace: streamed, or read whole and sorted; returns null on failure (after reporting it)
+ProcessManager* createTraceManager(char* path, unsigned int* settings, char isWhole, TraceReader** trace) {
+
+    // verify settings as parseManagerFromString does
+    if (settings[0] < 1 || settings[0] > MAX_NUM_CPUS || settings[1] >= NUM_ALGS) {
+        fprintf(stderr, "Invalid settings: 1-%d CPUs and an algorithm below %d\n", MAX_NUM_CPUS, NUM_ALGS);
+        return NULL;
+    }
+
+    // map trace
+    *trace = openTrace(path);
+    if (*trace == NULL) {
+        perror(path);
+        return NULL;
+    }
+    ProcessManager* procMgr = createProcessManager(settings[0], settings[1], settings[2]);
+    if (procMgr == NULL) return NULL;
+
+    // stream arrivals, or read every process (one over the limit to detect it) and sort them
+    int status = 0;
+    if (!isWhole)
+        status = useArrivalSource(procMgr, readTraceArrivals, *trace);
+    else {
+        int numRead = readTraceProcesses(*trace, &procMgr->unstarted, MAX_PROCESSES + 1);
+        if (numRead > MAX_PROCESSES) {
+            fprintf(stderr, "Trace has over %d processes (stream it instead of reading it whole)\n", MAX_PROCESSES);
+            freeProcessManager(procMgr);
+            return NULL;
+        }
+        status = numRead < 0 || sortProcessList(&procMgr->unstarted);
+    }
+    if (status) {
+        printTraceError(*trace);
+        freeProcessManager(procMgr);
+        return NULL;
+    }
+    return procMgr;
+}
+
+// live replay producer state
+typedef struct LiveReplay {
+
+    TraceReader* trace;
+    ProcessRing* ring;
+    atomic_int isStopped; // set by the simulation thread if it fails (so a producer waiting on a full ring exits)
+
+} LiveReplay;
+
+// producer thread: submits every trace record to the ring in trace order (waiting while it is full), then closes it
+void* replayTrace(void* arg) {
+
+    LiveReplay* replay = arg;
+    ProcessList chunk = createProcessList(NULL);
+    while (readTraceProcesses(replay->trace, &chunk, TRACE_CHUNK_PROCESSES) > 0) {
+        for (ProcessNode* procNode = chunk.head; procNode != NULL; procNode = procNode->next)
+            while (pushProcess(replay->ring, procNode->process.pid, procNode->process.startTime, procNode->process.duration)) {
+                if (atomic_load(&replay->isStopped)) break;
+                sched_yield();
+            }
+        freeProcessList(chunk);
+        chunk = createProcessList(NULL);
+        if (atomic_load(&replay->isStopped)) break;
+    }
+    freeProcessList(chunk);
+    closeProcessRing(replay->ring);
+    return NULL;
+}
+
+// waits until the producer has submitted every process starting by 'time' (one starting later was taken, or the ring is closed)
+// runs therefore match the trace's timing however the threads are scheduled; returns 1 on failure
+int waitForReplay(SimHandle* handle, unsigned long long time) {
+
+    ProcessList* unstarted = &handle->procMgr->unstarted;
+    while (!isProcessRingClosed(handle->ring) && (unstarted->tail == NULL || unstarted->tail->process.startTime <= time)) {
+        int numTaken = spmPoll(handle);
+        if (numTaken < 0) return 1;
+        if (numTaken == 0) sched_yield();
+    }
+    return 0;
+}
+
+// writes one stepped frame in the text or binary frame format
+void writeFrame(unsigned int* frame, unsigned int frameLength, enum OutputFormats format) {
+
+    if (format == OUTPUT_BINARY) {
+        fwrite(frame, sizeof(unsigned int), frameLength, stdout);
+        return;
+    }
+    printf("%u;", frame[0]);
+    for (unsigned int i = 1; i < frameLength && frame[i] != IDLE_CPU_PID; i += 2)
+        printf("%u,%u;", frame[i], frame[i + 1]);
+    putchar('\n');
+}
+
+// replays a trace into a live simulation (the trace is read on a producer thread, frames are stepped and written on this one); returns the exit status
+int runLiveReplay(char* path, unsigned int* settings, enum OutputFormats format, char isEngineStats) {
+
+    if (format != OUTPUT_TEXT && format != OUTPUT_BINARY && format != OUTPUT_NONE) {
+        fputs("Live replay writes text, binary or no frames\n", stderr);
+        return 2;
+    }
+
+    // map trace and create live simulation
+    LiveReplay replay = { .trace = openTrace(path), .ring = NULL };
+    atomic_init(&replay.isStopped, 0);
+    if (replay.trace == NULL) {
+        perror(path);
+        return 1;
+    }
+    SimConfig config = { .numCpus = settings[0], .alg = settings[1], .rrQuantum = settings[2] };
+    SimHandle* handle = spmCreateLive(&config, LIVE_RING_CAPACITY);
+    if (handle == NULL) {
+        if (spmGetError() == SPM_ERR_SETTINGS) fprintf(stderr, "Invalid settings: 1-%d CPUs and an algorithm below %d\n", MAX_NUM_CPUS, NUM_ALGS);
+        else fputs("Out of memory\n", stderr);
+        closeTrace(replay.trace);
+        return 1;
+    }
+    replay.ring = spmGetRing(handle);
+
+    // start producer
+    pthread_t producer;
+    if (pthread_create(&producer, NULL, replayTrace, &replay) != 0) {
+        fputs("Could not start replay thread\n", stderr);
+        spmDestroy(handle);
+        closeTrace(replay.trace);
+        return 1;
+    }
+
+    // step one second at a time once the producer is past it
+    int status = waitForReplay(handle, 0);
+    unsigned int* frame;
+    while (!status && (frame = spmReadFrame(handle)) != NULL) {
+        if (format != OUTPUT_NONE) writeFrame(frame, handle->frameLength, format);
+        status = waitForReplay(handle, handle->frameTime + 1);
+        int numStepped = status ? -1 : spmStep(handle, 1);
+        if (numStepped < 0) status = 1;
+        if (numStepped <= 0) break;
+    }
+    if (handle->procMgr->errFlag) status = 1;
+
+    // stop and join producer
+    atomic_store(&replay.isStopped, 1);
+    pthread_join(producer, NULL);
+    if (replay.trace->error != TRACE_OK) {
+        printTraceError(replay.trace);
+        status = 1;
+    } else if (status)
+        fprintf(stderr, "Simulation failed: %s\n", getRunError(handle->procMgr, spmGetError()));
+    if (isEngineStats)
+        printEngineStats(collectEngineStats(handle->procMgr));
+
+    spmDestroy(handle);
+    closeTrace(replay.trace);
+    return status;
+}
+
+int main(int argc, char** argv) {
+
+    // parse options
+    enum OutputFormats format = OUTPUT_TEXT;
+    SweepParams sweepParams;
+    char isSweep = 0, isPerCpu = 0, isEngineStats = 0, isTrace = 0, isWholeTrace = 0, isLive = 0;
+    char isGenerated = 0;
+    unsigned int numThreads = 0, traceSettings[3];
+    SimConfig genConfig;
+    GenParams genParams;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:s:j:t:g:ulpeh")) != -1) {
+        if (opt == 'f' && strcmp(optarg, "text") == 0) format = OUTPUT_TEXT;
+        else if (opt == 'f' && strcmp(optarg, "binary") == 0) format = OUTPUT_BINARY;
+        else if (opt == 'f' && strcmp(optarg, "none") == 0) format = OUTPUT_NONE;
+        else if (opt == 'f' && strcmp(optarg, "metrics") == 0) format = OUTPUT_METRICS;
+        else if (opt == 'f' && strcmp(optarg, "intervals") == 0) format = OUTPUT_INTERVALS;
+        else if (opt == 's' && sscanf(optarg, "%u,%u,%u,%u", &sweepParams.minCpus, &sweepParams.maxCpus, &sweepParams.minQuantum, &sweepParams.maxQuantum) == 4) isSweep = 1;
+        else if (opt == 'j') numThreads = strtoul(optarg, NULL, 10);
+        else if (opt == 't' && sscanf(optarg, "%u,%u,%u", &traceSettings[0], &traceSettings[1], &traceSettings[2]) == 3) isTrace = 1;
+        else if (opt == 'g' && parseGenerator(optarg, &genConfig, &genParams)) isGenerated = 1;
+        else if (opt == 'u') isWholeTrace = 1;
+        else if (opt == 'l') isLive = 1;
+        else if (opt == 'p') isPerCpu = 1;
+        else if (opt == 'e') isEngineStats = 1;
+        else {
+            printUsage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (argc - optind > 1 || (isTrace && argc - optind != 1) || (isGenerated && (isTrace || argc - optind != 0)) || (isLive && (!isTrace || isWholeTrace || isSweep || isPerCpu))) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // replay a trace live instead of running it as a batch
+    if (isLive)
+        return runLiveReplay(argv[optind], traceSettings, format, isEngineStats);
+
+    // create process manager from a trace (sweeps read it whole, as every configuration reruns it)
+    ProcessManager* procMgr = NULL;
+    TraceReader* trace = NULL;
+    if (isTrace) {
+        procMgr = createTraceManager(argv[optind], traceSettings, isWholeTrace || isSweep, &trace);
+        if (procMgr == NULL) {
+            closeTrace(trace);
+            return 1;
+        }
+
+    // or from the generator
+    } else if (isGenerated) {
+        procMgr = createGeneratedManager(&genConfig, &genParams);
+        if (procMgr == NULL) {
+            fprintf(stderr, "Could not generate workload: 1-%d CPUs, an algorithm below %d, at most %d processes and a bounded time span\n",
+                MAX_NUM_CPUS, NUM_ALGS, MAX_PROCESSES);
+            return 1;
+        }
+
+    // or from a workload string
+    } else {
+
+        // read workload
+        FILE* file = optind < argc ? fopen(argv[optind], "rb") : stdin;
+        if (file == NULL) {
+            perror(argv[optind]);
+            return 1;
+        }
+        char* workload = readWorkload(file);
+        if (file != stdin) fclose(file);
+        if (workload == NULL) {
+            fputs("Could not read workload\n", stderr);
+            return 1;
+        }
+
+        // create process manager
+        procMgr = parseManagerFromString(workload);
+        free(workload);
+        if (procMgr == NULL) {
+            fputs("Could not parse workload\n", stderr);
+            return 1;
+        }
+    }
+
+    // sweep every configuration over the parsed workload instead of running it once
+    if (isSweep) {
+        SweepTable* table = runSweep(&procMgr->unstarted, sweepParams, numThreads);
+        freeProcessManager(procMgr);
+        closeTrace(trace);
+        if (table == NULL) {
+            fprintf(stderr, "Sweep failed: ranges must give 1-%d CPUs, positive quanta and at most %d configurations\n", MAX_NUM_CPUS, MAX_SWEEP_CONFIGS);
+            return 1;
+        }
+        printSweep(table);
+        free(table);
+        return 0;
+    }
+    if (!isTrace && sortProcessList(&procMgr->unstarted)) {
+        fputs("Could not sort workload\n", stderr);
+        freeProcessManager(procMgr);
+        return 1;
+    }
+
+    // attach requested frame output
+    if (format == OUTPUT_TEXT) {
+        procMgr->frameStrCapacity = MAX_FRAME_STR_LEN(procMgr->numCpus) + 1;
+        procMgr->frameStr = malloc(procMgr->frameStrCapacity);
+        if (procMgr->frameStr != NULL) procMgr->frameStr[0] = '\0';
+        else procMgr->errFlag = SPM_ERR_MEMORY;
+    } else if (format == OUTPUT_BINARY) {
+        procMgr->frameBuf = createFrameBuffer(procMgr->numCpus);
+        if (procMgr->frameBuf == NULL) procMgr->errFlag = SPM_ERR_MEMORY;
+    } else if (format == OUTPUT_METRICS) {
+        procMgr->stats = createProcessStats();
+        if (procMgr->stats == NULL) procMgr->errFlag = SPM_ERR_MEMORY;
+    } else if (format == OUTPUT_INTERVALS) {
+        procMgr->intervals = createIntervalBuffer(procMgr->numCpus);
+        if (procMgr->intervals == NULL) procMgr->errFlag = SPM_ERR_MEMORY;
+    }
+
+    // switch to per-CPU run queues if requested
+    if (isPerCpu && !procMgr->errFlag && usePerCpuQueues(procMgr))
+        procMgr->errFlag = SPM_ERR_MEMORY;
+
+    // run
+    if (!procMgr->errFlag)
+        runAlgorithm(procMgr);
+
+    // write frames
+    int status = 0;
+    if (trace != NULL && trace->error != TRACE_OK) {
+        printTraceError(trace);
+        status = 1;
+    } else if (procMgr->errFlag) {
+        fprintf(stderr, "Simulation failed: %s\n", getRunError(procMgr, procMgr->errFlag));
+        status = 1;
+    } else if (format == OUTPUT_TEXT)
+        fwrite(procMgr->frameStr, 1, procMgr->frameStrLen, stdout);
+    else if (format == OUTPUT_BINARY) {
+
+        // an empty run never allocated its frames
+        if (procMgr->frameBuf->size > 0)
+            fwrite(procMgr->frameBuf->data, sizeof(unsigned int), procMgr->frameBuf->size, stdout);
+    } else if (format == OUTPUT_METRICS) {
+        printMetrics(summarizeProcessStats(procMgr->stats, procMgr->numCpus));
+        if (procMgr->runQueues != NULL) printf("steals: %llu\n", procMgr->runQueues->numSteals);
+    } else if (format == OUTPUT_INTERVALS)
+        printIntervals(procMgr->intervals);
+
+    if (isEngineStats)
+        printEngineStats(collectEngineStats(procMgr));
+
+    // free output and process manager
+    free(procMgr->frameStr);
+    freeFrameBuffer(procMgr->frameBuf);
+    freeIntervalBuffer(procMgr->intervals);
+    freeProcessManager(procMgr);
+    closeTrace(trace);
+    return status;
+}
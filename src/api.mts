@@ -1,6 +1,10 @@
 
 import { NextFunction, Request, Response, Router } from "express";
 import { AppDb, ProcessEntry } from "./crud.mjs";
+import { MAX_NUM_CPUS, MAX_PROCESSES, MAX_TIME_AND_PID, NUM_ALGS } from "./public/scripts/limits.mjs";
+import { usesQuantum } from "./public/scripts/algs.mjs";
+import { SimCache } from "./sim-cache.mjs";
+import { SimFormat, SimLimitError, SimPool, SimPoolBusyError, toMetricsObject } from "./sim-pool.mjs";
 
 const router = Router();
 
@@ -20,8 +24,9 @@ router.route('/spm')
     })
     .post(async (req: Request, res: Response, next: NextFunction) => {
 
-        // get db client
+        // get db client and simulation cache
         const dbClient = res.locals._dbClient as AppDb;
+        const simCache = res.locals._simCache as SimCache;
 
         try {
 
@@ -45,11 +50,14 @@ router.route('/spm')
                     });
                 }
 
-                // delete all elements and insert docs
+                // delete all elements and insert docs (the cached process set is dropped as soon as the old one is gone, even if the insert fails)
                 dbClient.delete<ProcessEntry>('spm', {})
-                    .then(dbRes => dbClient.create<ProcessEntry>('spm', ...docs))
-                    .then(dbRes => dbRes ? res.status(200).json({ docInsertCount: dbRes.insertedCount }) : null)
-                    .catch(console.error);
+                    .then(dbRes => {
+                        simCache.invalidateProcesses();
+                        return dbClient.create<ProcessEntry>('spm', ...docs);
+                    })
+                    .then(dbRes => res.status(200).json({ docInsertCount: dbRes.insertedCount }))
+                    .catch(next);
 
                 return;
             }
@@ -66,12 +74,12 @@ router.route('/spm')
                 start_time: +req.body.start_time,
                 duration: +req.body.duration
             };
-            if (!Number.isInteger(doc.pid) || doc.pid < 0 || doc.pid > 255 ||
+            if (!Number.isInteger(doc.pid) || doc.pid < 0 || doc.pid > MAX_TIME_AND_PID ||
                 doc.name.length > 64 ||
                 doc.owner.length > 64 ||
-                !Number.isInteger(doc.start_time) || doc.start_time < 0 || doc.start_time > 255 ||
-                !Number.isInteger(doc.duration) || doc.duration < 0 || doc.duration > 255)
-                throw new Error('Invalid parameters (string length must be <= 64, number range must be [0, 255])');
+                !Number.isInteger(doc.start_time) || doc.start_time < 0 || doc.start_time > MAX_TIME_AND_PID ||
+                !Number.isInteger(doc.duration) || doc.duration < 0 || doc.duration > MAX_TIME_AND_PID)
+                throw new Error(`Invalid parameters (string length must be <= 64, number range must be [0, ${MAX_TIME_AND_PID}])`);
 
             // insert data if pid doesn't exist
             dbClient.read<ProcessEntry>('spm', { pid: doc.pid })
@@ -86,7 +94,11 @@ router.route('/spm')
                     // otherwise, create entry
                     return dbClient.create<ProcessEntry>('spm', doc);
                 })
-                .then(dbRes => dbRes ? res.status(200).json({ docInsertCount: dbRes.insertedCount }) : null)
+                .then(dbRes => {
+                    if (!dbRes) return;
+                    if (dbRes.insertedCount > 0) simCache.invalidateProcesses();
+                    res.status(200).json({ docInsertCount: dbRes.insertedCount });
+                })
                 .catch(next);
 
         } catch (err: any) {
@@ -97,8 +109,9 @@ router.route('/spm')
     })
     .put(async (req: Request, res: Response, next: NextFunction) => {
 
-        // get db client
+        // get db client and simulation cache
         const dbClient = res.locals._dbClient as AppDb;
+        const simCache = res.locals._simCache as SimCache;
 
         try {
 
@@ -108,8 +121,8 @@ router.route('/spm')
 
             // validate (if orig_pid is valid)
             const origPid = +req.body.orig_pid;
-            if (!Number.isInteger(origPid) || origPid < 0 || origPid > 255)
-                throw new Error('Invalid PID (number range must be [0, 255])');
+            if (!Number.isInteger(origPid) || origPid < 0 || origPid > MAX_TIME_AND_PID)
+                throw new Error(`Invalid PID (number range must be [0, ${MAX_TIME_AND_PID}])`);
 
             // validate (if any other data exists)
             let updateObj: Partial<ProcessEntry> = {};
@@ -122,12 +135,12 @@ router.route('/spm')
                 throw new Error('No data to update with');
 
             // validate (if provided data is valid)
-            if ((updateObj.pid !== undefined && (!Number.isInteger(updateObj.pid) || updateObj.pid < 0 || updateObj.pid > 255)) ||
+            if ((updateObj.pid !== undefined && (!Number.isInteger(updateObj.pid) || updateObj.pid < 0 || updateObj.pid > MAX_TIME_AND_PID)) ||
                 (updateObj.name !== undefined && updateObj.name.length > 64) ||
                 (updateObj.owner !== undefined && updateObj.owner.length > 64) ||
-                (updateObj.start_time !== undefined && (!Number.isInteger(updateObj.start_time) || updateObj.start_time < 0 || updateObj.start_time > 255)) ||
-                (updateObj.duration !== undefined && (!Number.isInteger(updateObj.duration) || updateObj.duration < 0 || updateObj.duration > 255)))
-                throw new Error('Invalid update parameters (string length must be <= 64, number range must be [0, 255])');
+                (updateObj.start_time !== undefined && (!Number.isInteger(updateObj.start_time) || updateObj.start_time < 0 || updateObj.start_time > MAX_TIME_AND_PID)) ||
+                (updateObj.duration !== undefined && (!Number.isInteger(updateObj.duration) || updateObj.duration < 0 || updateObj.duration > MAX_TIME_AND_PID)))
+                throw new Error(`Invalid update parameters (string length must be <= 64, number range must be [0, ${MAX_TIME_AND_PID}])`);
 
             // insert data if updated pid doesn't exist
             dbClient.read<ProcessEntry>('spm', { pid: updateObj.pid })
@@ -142,7 +155,14 @@ router.route('/spm')
                     // otherwise, update
                     return dbClient.update<ProcessEntry>('spm', { pid: origPid }, updateObj);
                 })
-                .then(dbRes => dbRes ? res.status(200).json({ docUpdateCount: dbRes.modifiedCount }) : null)
+                .then(dbRes => {
+
+                    // names and owners are not simulated, so only pid and time changes invalidate
+                    if (!dbRes) return;
+                    if (dbRes.modifiedCount > 0 && (updateObj.pid !== undefined || updateObj.start_time !== undefined || updateObj.duration !== undefined))
+                        simCache.invalidateProcesses();
+                    res.status(200).json({ docUpdateCount: dbRes.modifiedCount });
+                })
                 .catch(next);
 
         } catch (err: any) {
@@ -153,8 +173,9 @@ router.route('/spm')
     })
     .delete(async (req: Request, res: Response, next: NextFunction) => {
 
-        // get db client
+        // get db client and simulation cache
         const dbClient = res.locals._dbClient as AppDb;
+        const simCache = res.locals._simCache as SimCache;
 
         try {
 
@@ -164,12 +185,15 @@ router.route('/spm')
 
             // validate (if pid is valid)
             const pid = +req.body.pid;
-            if (!Number.isInteger(pid) || pid < 0 || pid > 255)
-                throw new Error('Invalid PID (number range must be [0-255])');
+            if (!Number.isInteger(pid) || pid < 0 || pid > MAX_TIME_AND_PID)
+                throw new Error(`Invalid PID (number range must be [0-${MAX_TIME_AND_PID}])`);
 
             // attempt to delete doc
             dbClient.delete<ProcessEntry>('spm', { pid: pid })
-                .then(dbRes => res.status(200).json({ docDeleteCount: dbRes.deletedCount }))
+                .then(dbRes => {
+                    if (dbRes.deletedCount > 0) simCache.invalidateProcesses();
+                    res.status(200).json({ docDeleteCount: dbRes.deletedCount });
+                })
                 .catch(next);
 
         } catch (err: any) {
@@ -179,4 +203,97 @@ router.route('/spm')
         }
     });
 
+// builds the engine's process input ('pid,start,duration,...' in pid order) straight from the spm collection
+// the string is cached until the next change to the collection
+async function readProcessParamStr(dbClient: AppDb, simCache: SimCache): Promise<string> {
+
+    if (simCache.processStr !== undefined) return simCache.processStr;
+
+    let params: string[] = [];
+    const version = simCache.processVersion;
+    const cursor = dbClient.readCursor<ProcessEntry>('spm', {}, { _id: 0, pid: 1, start_time: 1, duration: 1 }).sort({ pid: 1 });
+    for await (const doc of cursor) {
+        if (params.length === MAX_PROCESSES)
+            throw new Error(`Too many processes (count must be <= ${MAX_PROCESSES})`);
+        params.push(`${doc.pid},${doc.start_time},${doc.duration},`);
+    }
+    const processStr = params.join('');
+    simCache.setProcessStr(processStr, version);
+    return processStr;
+}
+
+router.post('/spm/simulate', async (req: Request, res: Response, next: NextFunction) => {
+
+    // get db client, simulation pool and cache
+    const dbClient = res.locals._dbClient as AppDb;
+    const simPool = res.locals._simPool as SimPool;
+    const simCache = res.locals._simCache as SimCache;
+
+    let settingsStr: string;
+    let format: SimFormat;
+    try {
+
+        // validate (if vars exist)
+        if (req.body.num_cpus === undefined || req.body.alg === undefined)
+            throw new Error('Missing parameters');
+
+        // validate (if vars are valid)
+        const numCpus = +req.body.num_cpus;
+        const alg = +req.body.alg;
+        const rrQuantum = req.body.rr_quantum === undefined ? 1 : +req.body.rr_quantum;
+        format = req.body.format ?? 'metrics';
+        if (!Number.isInteger(numCpus) || numCpus <= 0 || numCpus > MAX_NUM_CPUS ||
+            !Number.isInteger(alg) || alg < 0 || alg >= NUM_ALGS ||
+            !Number.isInteger(rrQuantum) || rrQuantum <= 0 || rrQuantum > MAX_TIME_AND_PID)
+            throw new Error(`Invalid parameters (CPU range must be [1, ${MAX_NUM_CPUS}], algorithm range must be [0, ${NUM_ALGS - 1}], quantum range must be [1, ${MAX_TIME_AND_PID}])`);
+        if (format !== 'metrics' && format !== 'frames' && format !== 'intervals')
+            throw new Error('Invalid format (must be \'metrics\', \'frames\' or \'intervals\')');
+
+        // algorithms without a quantum ignore it, so it is written as 0 to keep one cache key per simulation
+        settingsStr = `${numCpus},${alg},${usesQuantum(alg) ? rrQuantum : 0},`;
+
+    } catch (err: any) {
+
+        console.error(err?.message);
+        res.status(400).json(err?.message);
+        return;
+    }
+
+    // run on the worker pool unless cached; metrics as json, frames or intervals as raw words (counts in headers)
+    readProcessParamStr(dbClient, simCache)
+        .then(processStr => {
+            const paramStr = settingsStr + processStr;
+            return simCache.getOrRun(SimCache.getKey(format, paramStr), () => simPool.run(paramStr, format));
+        })
+        .then(simRes => {
+            if (simRes.intervals !== undefined) {
+                res.status(200)
+                    .set({
+                        'Content-Type': 'application/octet-stream',
+                        'X-Interval-Count': String(simRes.numIntervals),
+                        'X-Queue-Point-Count': String(simRes.numQueuePoints),
+                        'X-Frame-Count': String(simRes.numFrames)
+                    })
+                    .send(Buffer.from(simRes.intervals));
+                return;
+            }
+            if (simRes.frames === undefined) {
+                res.status(200).json(toMetricsObject(simRes.metrics as number[]));
+                return;
+            }
+            res.status(200)
+                .set({
+                    'Content-Type': 'application/octet-stream',
+                    'X-Frame-Stride': String(simRes.stride),
+                    'X-Frame-Count': String(simRes.numFrames)
+                })
+                .send(Buffer.from(simRes.frames));
+        })
+        .catch(err => {
+            if (!(err instanceof SimPoolBusyError) && !(err instanceof SimLimitError)) return next(err);
+            console.error(err.message);
+            res.status(err instanceof SimPoolBusyError ? 503 : 413).json(err.message);
+        });
+});
+
 export default router;
\ No newline at end of file
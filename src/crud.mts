@@ -53,6 +53,17 @@ export class AppDb {
         return this._dbClient.db(AppDb._dbName).collection<T>(collection).find(filter).toArray();
     }
 
+    /**
+     * Reads selected fields of database entries in a specified collection, one batch at a time.
+     * @param {string} collection The collection to query.
+     * @param {Filter<T>} filter The query to try.
+     * @param {Document} projection The fields to return.
+     * @returns {FindCursor<WithId<T>>} A cursor over the matching entries.
+     */
+    public readCursor<T extends Document>(collection: string, filter: Filter<T>, projection: Document): FindCursor<WithId<T>> {
+        return this._dbClient.db(AppDb._dbName).collection<T>(collection).find(filter, { projection });
+    }
+
     /**
      * Updates database entries in a specified collection.
      * @param {string} collection The collection to update.
@@ -7,6 +7,8 @@ import { MongoClient } from 'mongodb';
 import { AppDb, User } from './crud.mjs';
 import apiRouter from './api.mjs';
 import loginRouter from './login.mjs';
+import { SimCache } from './sim-cache.mjs';
+import { SimPool } from './sim-pool.mjs';
 import bodyParser from 'body-parser';
 import cookieParser from 'cookie-parser';
 import jwt from 'jsonwebtoken';
@@ -21,6 +23,13 @@ if (!checkEnvVars(process.env)) {
 const app = express();
 app.set('views', path.join(import.meta.dirname, 'templates'));
 app.set('view engine', 'pug');
+
+// cross-origin isolate pages so the sweep module's threads can share WASM memory (SharedArrayBuffer)
+app.use((req: Request, res: Response, next: NextFunction) => {
+    res.setHeader('Cross-Origin-Opener-Policy', 'same-origin');
+    res.setHeader('Cross-Origin-Embedder-Policy', 'credentialless');
+    next();
+});
 app.use(express.static(path.join(import.meta.dirname, 'public')));
 app.use(bodyParser.json());
 app.use(bodyParser.urlencoded({
@@ -44,14 +53,19 @@ if ((await dbClient.read<User>('users', { uname: process.env.APP_DEFAULT_USER })
         process.exit(1);
     }
 }
+// start simulation worker pool (SIM_WORKERS is optional; defaults to one worker per core)
+const simPool = new SimPool(process.env.SIM_WORKERS !== undefined ? +process.env.SIM_WORKERS : undefined);
 
-
+// cache simulation results (SIM_CACHE_BYTES is optional; defaults to 256 MiB)
+const simCache = new SimCache(process.env.SIM_CACHE_BYTES !== undefined ? +process.env.SIM_CACHE_BYTES : undefined);
 
 // basic middleware
 app.use((req: Request, res: Response, next: NextFunction) => {
 
-    // attach db client to response locals
+    // attach db client, simulation pool and cache to response locals
     res.locals._dbClient = dbClient;
+    res.locals._simPool = simPool;
+    res.locals._simCache = simCache;
 
     // log
     console.log(`Incoming request from: ${req.ip}`);
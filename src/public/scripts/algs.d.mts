@@ -0,0 +1,6 @@
+// Type declarations for the algorithm module (src/public/scripts/algs.mjs).
+
+export declare const ALG_NAMES: string[];
+export declare const ALG_RR: number;
+export declare const ALG_MLFQ: number;
+export declare function usesQuantum(alg: number): boolean;
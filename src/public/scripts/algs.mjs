@@ -0,0 +1,11 @@
+// This module names the engine's scheduling algorithms (enum SchedAlgs in procmgr.h) for the dashboard and the API.
+
+// algorithm names by enum value
+export const ALG_NAMES = ['FIFO', 'LIFO', 'RR', 'SJF', 'LJF', 'SRTF', 'MLFQ'];
+
+// algorithms that take a quantum (mirrors USES_QUANTUM in procmgr.h)
+export const ALG_RR = 2;
+export const ALG_MLFQ = 6;
+export function usesQuantum(alg) {
+    return alg === ALG_RR || alg === ALG_MLFQ;
+}
@@ -1,12 +1,14 @@
 
 import { Tabulator, EditModule } from 'https://unpkg.com/tabulator-tables@6.3.0/dist/js/tabulator_esm.min.mjs';
 import { ArcElement, Chart, Colors, Legend, PieController, Title } from 'https://cdn.jsdelivr.net/npm/chart.js@4.4.4/+esm'
+import { MAX_NUM_CPUS, MAX_PROCESSES, MAX_RING_CAPACITY, MAX_SWEEP_CONFIGS, MAX_TIME_AND_PID, NUM_ALGS, NUM_QUANTUM_ALGS } from './limits.mjs';
+import { MAX_CACHE_BYTES, getCacheKey, getCachedRun, putCachedRun } from './simcache.mjs';
+import { IDLE_CPU_PID, createFrameReader } from './intervals.mjs';
+import { ALG_NAMES, usesQuantum } from './algs.mjs';
+import { createRingWriter } from './procring.mjs';
 
-// constants
-const MAX_TIME_AND_PID = 255;
+// constants (engine limits are shared through limits.mjs)
 const MAX_NAME_LENGTH = 64;
-const MAX_NUM_CPUS = 16;
-const MAX_PROCESSES = 255;
 
 // queue size element
 const queueSizeP = document.querySelector('#queue-size');
@@ -59,12 +61,11 @@ const mainTable = new Tabulator('#table', {
     columns: [
         { title: 'Process ID', field: 'pid', editor: 'number', editorParams: {
             selectContents: true,
-            mask: 999,
             min: 0,
-            max: 255,
+            max: MAX_TIME_AND_PID,
             step: 1,
             elementAttributes: {
-                maxlength: '3'
+                maxlength: `${String(MAX_TIME_AND_PID).length}`
             }
         }},
         { title: 'Process Name', field: 'name', editor: 'input', editorParams: {
@@ -83,22 +84,20 @@ const mainTable = new Tabulator('#table', {
         } },
         { title: 'Start Time (s)', field: 'start_time', editor: 'number', editorParams: {
             selectContents: true,
-            mask: 999,
             min: 0,
-            max: 255,
+            max: MAX_TIME_AND_PID,
             step: 1,
             elementAttributes: {
-                maxlength: '3'
+                maxlength: `${String(MAX_TIME_AND_PID).length}`
             }
         }},
         { title: 'Duration (s)', field: 'duration', editor: 'number', editorParams: {
             selectContents: true,
-            mask: 999,
             min: 0,
-            max: 255,
+            max: MAX_TIME_AND_PID,
             step: 1,
             elementAttributes: {
-                maxlength: '3'
+                maxlength: `${String(MAX_TIME_AND_PID).length}`
             }
         }}
     ]
@@ -191,98 +190,594 @@ const liveTable = new Tabulator('#live-table', {
     ]
 });
 
-function displayFrames() {
+// playback controls
+const playBtn = document.querySelector('button#play-btn');
+const seekInput = document.querySelector('input#seek');
+const speedSelect = document.querySelector('select#speed');
+const playbackTimeP = document.querySelector('p#playback-time');
+
+// playback cursor over the shown run (one requestAnimationFrame loop advances 'time' in simulated seconds; a frame is rebuilt only when its second changes)
+const playback = {
+    readFrame: null,
+    numFrames: 0,
+    time: 0,
+    shownFrame: -1,
+    lastTimestamp: null,
+    animationId: null
+};
+
+// SimConfig words (numCpus, alg, rrQuantum; see procmgr.h), written right before the (pid, start, duration) words of the engine input
+const SIM_CONFIG_WORDS = 3;
+
+// GenParams settings not offered on the page (mean duration, target utilization in percent, burst size; see procgen.h)
+const GEN_MEAN_DURATION = 3;
+const GEN_UTILIZATION = 90;
+const GEN_BURST_SIZE = 64;
+
+// engine error messages by code (see SpmErrors in procmgr.h)
+const ENGINE_ERRORS = [
+    'No error',
+    'Engine input is missing or malformed',
+    `Process manager settings are out of range - number of CPUs must be 1-${MAX_NUM_CPUS} and algorithm type must be 0-${NUM_ALGS - 1} (a synthetic workload may also span too much time)`,
+    `Process list validation failed - there may not be more than ${MAX_PROCESSES} processes`,
+    'Engine ran out of memory',
+    'Simulation is too large to show - its frames would pass the output limit or its time the 32-bit limit'
+];
+
+// simulation worker (owns the engine and its re-simulation session; see engine-worker.mjs)
+const engineWorker = new Worker('/scripts/engine-worker.mjs', { type: 'module' });
+const pendingRuns = new Map(); // request id -> { resolve, reject }
+let nextRunId = 0;
+const engineReady = new Promise((resolve, reject) => {
+
+    // settle requests as replies arrive (the first message only says the engine loaded; live replies resolve with the whole reply)
+    engineWorker.onmessage = ({ data }) => {
+        if (data.ready) {
+            resolve();
+            return;
+        }
+        const pendingRun = pendingRuns.get(data.id);
+        pendingRuns.delete(data.id);
+        if (data.errorCode !== undefined) {
+            pendingRun.reject(new Error(ENGINE_ERRORS[data.errorCode] ?? 'Could not run simulation'));
+            return;
+        }
+        if (data.result === undefined) {
+            pendingRun.resolve(data);
+            return;
+        }
+        console.debug('Engine statistics', data.stats);
+        pendingRun.resolve(data.result);
+    };
+
+    // a failed worker fails every run
+    engineWorker.onerror = event => {
+        const err = new Error(`Simulation worker failed - ${event.message ?? 'could not load engine'}`);
+        reject(err);
+        pendingRuns.forEach(pendingRun => pendingRun.reject(err));
+        pendingRuns.clear();
+    };
+});
+
+// validates the process table; returns its processes in pid order (like the server)
+function getSortedProcesses() {
+
+    // validate number of processes
+    const processes = mainTable.getData().sort((a, b) => a.pid - b.pid);
+    if (processes.length > MAX_PROCESSES)
+        throw new Error(`Process list validation failed - there may not be more than ${MAX_PROCESSES} processes`);
+
+    // validate processes
+    for (const obj of processes)
+        if (obj.pid < 0 || obj.pid > MAX_TIME_AND_PID ||
+            obj.start_time < 0 || obj.start_time > MAX_TIME_AND_PID ||
+            obj.duration < 0 || obj.duration > MAX_TIME_AND_PID)
+            throw new Error(`Process list validation failed - times and process IDs must be less than or equal to ${MAX_TIME_AND_PID}`);
+    return processes;
+}
+
+// validates the process table and writes it as 'pid,start,duration,...' for the sweep module
+function getProcessParamStr() {
+
+    return getSortedProcesses().map(obj => `${obj.pid},${obj.start_time},${obj.duration},`).join('');
+}
+
+// returns the engine input for the settings and validated process table (SimConfig, then one word triple per process)
+function getEngineInput(numCpus, algType, rrQuantum) {
+
+    const processes = getSortedProcesses();
+    const input = new Uint32Array(SIM_CONFIG_WORDS + 3 * processes.length);
+    input[0] = numCpus;
+    input[1] = algType;
+    input[2] = rrQuantum;
+    let i = SIM_CONFIG_WORDS;
+    for (const obj of processes) {
+        input[i++] = obj.pid;
+        input[i++] = obj.start_time;
+        input[i++] = obj.duration;
+    }
+    return input;
+}
+
+// returns the generator input for the settings and synthetic workload fields (SimConfig, then GenParams)
+// it never has the length of a table input (3 words per process), so both share the run cache
+function getGeneratedInput(numCpus, algType, rrQuantum) {
+
+    // validate synthetic workload fields (the seed is split into two words)
+    const numProcesses = +document.querySelector('input#synthCount')?.valueAsNumber;
+    const seed = +document.querySelector('input#synthSeed')?.valueAsNumber;
+    if (!Number.isInteger(numProcesses) || numProcesses < 1 || numProcesses > MAX_PROCESSES ||
+        !Number.isSafeInteger(seed) || seed < 0)
+        throw new Error(`Synthetic workload validation failed - there must be 1-${MAX_PROCESSES} processes and the seed must be a non-negative integer`);
+    return new Uint32Array([
+        numCpus, algType, rrQuantum,
+        numProcesses, +document.querySelector('select#synthArrivals').value, +document.querySelector('select#synthDurations').value,
+        GEN_MEAN_DURATION, GEN_UTILIZATION, GEN_BURST_SIZE, seed % 2 ** 32, Math.floor(seed / 2 ** 32)
+    ]);
+}
+
+// sends a request to the worker (see engine-worker.mjs for the message formats); resolves with its result
+async function requestWorker(message, transfer = []) {
+
+    await engineReady;
+    return new Promise((resolve, reject) => {
+        const id = nextRunId++;
+        pendingRuns.set(id, { resolve, reject });
+        engineWorker.postMessage({ id, ...message }, transfer);
+    });
+}
+
+// runs an engine or generator input on the worker (its buffer is transferred, so 'input' is unusable afterwards)
+// resolves with { numCpus, numFrames, intervals, queuePoints }
+async function runInWorker(input, isGenerated) {
+
+    return requestWorker(isGenerated ? { generate: input } : { input }, [input.buffer]);
+}
+
+// shows frame words (first word = queue size, rest are pid / remaining time pairs per CPU) with a time label
+function showFrameWords(frame, timeText) {
+
+    // set text to queue size and position
+    queueSizeP.textContent = `Queue Size: ${frame[0]}`;
+    playbackTimeP.textContent = timeText;
+
+    // iterate through CPUs and set table (skip idle CPUs)
+    let processes = [];
+    for (let j = 1; j < frame.length; j += 2)
+        if (frame[j] !== IDLE_CPU_PID)
+            processes.push({ pid: frame[j], remaining_time: frame[j + 1] });
+    liveTable.setData(processes);
+}
+
+// shows the frame of the played run at a second
+function showFrame(index) {
+
+    showFrameWords(playback.readFrame(index), `Time: ${index} / ${playback.numFrames - 1} s`);
+    seekInput.value = index;
+    playback.shownFrame = index;
+}
+
+function pausePlayback() {
+
+    cancelAnimationFrame(playback.animationId);
+    playback.animationId = null;
+    playBtn.textContent = 'Play';
+}
+
+// advances the cursor by the elapsed time (scaled by the speed) and shows its frame if the second changed
+function stepPlayback(timestamp) {
+
+    if (playback.lastTimestamp !== null)
+        playback.time += (timestamp - playback.lastTimestamp) / 1000 * +speedSelect.value;
+    playback.lastTimestamp = timestamp;
+
+    // the last frame stays shown for its second, then playback stops on it
+    if (playback.time >= playback.numFrames) {
+        playback.time = playback.numFrames - 1;
+        if (playback.shownFrame !== playback.numFrames - 1) showFrame(playback.numFrames - 1);
+        pausePlayback();
+        return;
+    }
+    const index = Math.floor(playback.time);
+    if (index !== playback.shownFrame) showFrame(index);
+    playback.animationId = requestAnimationFrame(stepPlayback);
+}
+
+function resumePlayback() {
+
+    if (playback.readFrame === null || playback.animationId !== null) return;
+    stopLive();
+
+    // replay from the start once the end was reached
+    if (playback.time >= playback.numFrames - 1) playback.time = 0;
+    playback.lastTimestamp = null;
+    playback.animationId = requestAnimationFrame(stepPlayback);
+    playBtn.textContent = 'Pause';
+}
+
+// plays a finished run ({ numCpus, numFrames, intervals, queuePoints }) from its start
+function playRun(result) {
+
+    pausePlayback();
+    stopLive();
+    playback.readFrame = createFrameReader(result);
+    playback.numFrames = result.numFrames;
+    playback.time = 0;
+    seekInput.max = Math.max(result.numFrames - 1, 0);
+    seekInput.disabled = result.numFrames === 0;
+    if (result.numFrames === 0) {
+        playback.readFrame = null;
+        return;
+    }
+    showFrame(0);
+    resumePlayback();
+}
+
+// validates the process manager settings; returns { numCpus, algType, rrQuantum }
+function getSettings() {
+
+    // input elements
+    const numCpusInput = document.querySelector('input#numCpus');
+    const algTypeInput = document.querySelector('input[name=algType]:checked');
+    const rrQuantumInput = document.querySelector('input#rrQuantum');
+
+    // validate process manager data
+    const numCpus = +numCpusInput?.valueAsNumber;
+    const algType = +algTypeInput?.value;
+    const rrQuantum = +rrQuantumInput?.valueAsNumber;
+    if (!Number.isInteger(numCpus) || numCpus < 1 || numCpus > MAX_NUM_CPUS ||
+        !Number.isInteger(algType) || algType < 0 || algType >= NUM_ALGS ||
+        !Number.isInteger(rrQuantum) || rrQuantum < 1 || rrQuantum > MAX_TIME_AND_PID)
+        throw new Error(`Process manager settings validation failed - number of CPUs must be 1-${MAX_NUM_CPUS}, algorithm type must be 0-${NUM_ALGS - 1}, and round robin quantum must be 1-${MAX_TIME_AND_PID}`);
+
+    // algorithms without a quantum ignore it, so it is 0 for them (one cache key and session run per simulation)
+    return { numCpus, algType, rrQuantum: usesQuantum(algType) ? rrQuantum : 0 };
+}
+
+// latest run started (an older run that finishes later is not shown)
+let latestRunId = 0;
+
+// runs the settings with the process table, or with a synthetic workload generated in the engine
+async function displayFrames(isGenerated) {
 
     // wrap all with try
+    const runId = ++latestRunId;
     try {
 
-        // input elements
-        const numCpusInput = document.querySelector('input#numCpus');
-        const algTypeInput = document.querySelector('input[name=algType]:checked');
-        const rrQuantumInput = document.querySelector('input#rrQuantum');
-
         // validate process manager data
-        const numCpus = +numCpusInput?.valueAsNumber;
-        const algType = +algTypeInput?.value;
-        const rrQuantum = +rrQuantumInput?.valueAsNumber;
-        console.log(numCpus);
-        console.log(algTypeInput?.value);
-        console.log(rrQuantum);
-        if (!Number.isInteger(numCpus) || numCpus < 1 || numCpus > MAX_NUM_CPUS ||
-            !Number.isInteger(algType) || algType < 0 || algType > 4 ||
-            !Number.isInteger(rrQuantum) || rrQuantum < 1 || rrQuantum > MAX_TIME_AND_PID)
-            throw new Error(`Process manager settings validation failed - number of CPUs must be 1-16, algorithm type must be 0-4, and round robin quantum must be 1-${MAX_TIME_AND_PID}`);
-
-        // validate number of processes
-        else if (tableData.length > MAX_PROCESSES)
-            throw new Error(`Process list validation failed - there may not be more than ${MAX_PROCESSES} processes`);
+        const { numCpus, algType, rrQuantum } = getSettings();
 
-        // generate param string to hand to wasm
-        let paramStr = `${numCpus},${algType},${rrQuantum},`;
-        for (const obj of tableData) {
+        // build input (the cache key is hashed from the same words, before they are transferred to the worker)
+        const input = isGenerated ? getGeneratedInput(numCpus, algType, rrQuantum) : getEngineInput(numCpus, algType, rrQuantum);
+        const cacheKey = await getCacheKey(input);
 
-            // validate processes
-            if (obj.pid < 0 || obj.pid > MAX_TIME_AND_PID ||
-                obj.start_time < 0 || obj.start_time > MAX_TIME_AND_PID ||
-                obj.duration < 0 || obj.duration > MAX_TIME_AND_PID)
-                throw new Error(`Process list validation failed - times and process IDs must be less than or equal to ${MAX_TIME_AND_PID}`);
+        // replay a cached run if this input was simulated before (IndexedDB may be unavailable, e.g. in private windows)
+        const cached = await getCachedRun(cacheKey).catch(err => console.error(err));
 
-            // good to go, write to param string
-            paramStr += `${obj.pid},${obj.start_time},${obj.duration},`;
-        }
+        // otherwise run it on the worker (reusing what the session can of its last table run)
+        const result = cached ?? await runInWorker(input, isGenerated);
+
+        // and cache the result
+        if (cached === undefined && result.intervals.byteLength + result.queuePoints.byteLength <= MAX_CACHE_BYTES)
+            putCachedRun(cacheKey, result).catch(console.error);
+        if (runId !== latestRunId) return;
+
+        // successful; remove error feedback if present
+        simErrP.textContent = '';
+        simErrDiv.style.display = 'none';
+
+        // replace playback of the previous run
+        playRun(result);
+
+    // handle custom throws
+    } catch (err) {
+
+        console.error(err);
+        if (runId !== latestRunId) return;
+        simErrP.textContent = err?.message;
+        simErrDiv.style.display = 'block';
+        return;
+    }
+}
+
+playBtn.addEventListener('click', () => playback.animationId === null ? resumePlayback() : pausePlayback());
+
+// seeking moves the cursor to the start of a second (playback continues from there if running)
+seekInput.addEventListener('input', () => {
+    if (playback.readFrame === null) return;
+    playback.time = seekInput.valueAsNumber;
+    playback.lastTimestamp = null;
+    showFrame(playback.time);
+});
+document.querySelector('button#start-btn').addEventListener('click', () => displayFrames(false));
+document.querySelector('button#synth-btn').addEventListener('click', () => displayFrames(true));
 
-        // run c (these strings must be freed)
-        const cParamStr = stringToNewUTF8(paramStr);
-        const cRetStr = UTF8ToString(_getFrames(cParamStr));
-        _free(cParamStr);
 
-        // check error
-        if (cRetStr.startsWith('E')) {
-            _free(cRetStr);
-            throw new Error(cRetStr.substring(1));
-        }
+
+/**************************************************/
+/* Live Injection                                 */
+/**************************************************/
+
+// live controls
+const liveBtn = document.querySelector('button#live-btn');
+const injectBtn = document.querySelector('button#inject-btn');
+const closeLiveBtn = document.querySelector('button#close-live-btn');
+
+// smallest live ring (the table is submitted at once, so a larger table gets a ring that holds all of it)
+const MIN_LIVE_RING_CAPACITY = 1024;
+
+// live simulation shown in the live table (the engine worker steps it; this page is its ring's only producer, see procring.mjs)
+// a requestAnimationFrame loop moves 'time' at the playback speed and asks the worker for the seconds it passed, one request at a time
+const live = {
+    writer: null,
+    shownTime: 0,
+    time: 0,
+    lastTimestamp: null,
+    animationId: null,
+    isStepping: false,
+    isClosed: false
+};
+
+// shows a live frame (the live simulation has no known end, so only its time is shown)
+function showLiveFrame(frame) {
+
+    showFrameWords(frame, `Time: ${live.shownTime} s (live${live.isClosed ? ', closed' : ''})`);
+}
+
+function showLiveError(err) {
+
+    console.error(err);
+    simErrP.textContent = err?.message;
+    simErrDiv.style.display = 'block';
+}
+
+// ends the live view (closing its ring, so the worker's simulation can finish)
+function stopLive() {
+
+    if (live.writer === null) return;
+    if (!live.isClosed) live.writer.close();
+    cancelAnimationFrame(live.animationId);
+    live.writer = null;
+    live.animationId = null;
+    injectBtn.disabled = true;
+    closeLiveBtn.disabled = true;
+}
+
+// steps the live simulation by the seconds the cursor passed and shows the frame reached; it stops once every process is done after the ring was closed
+async function stepLive(timestamp) {
+
+    if (live.lastTimestamp !== null)
+        live.time += (timestamp - live.lastTimestamp) / 1000 * +speedSelect.value;
+    live.lastTimestamp = timestamp;
+    live.animationId = requestAnimationFrame(stepLive);
+
+    // one step request at a time (a slow step lets the cursor run ahead, and the next request catches up)
+    const numFrames = Math.floor(live.time) - live.shownTime;
+    if (live.isStepping || numFrames <= 0) return;
+    live.isStepping = true;
+    const writer = live.writer;
+    try {
+        const { numStepped, frame } = await requestWorker({ liveStep: numFrames });
+        if (live.writer !== writer) return;
+        live.shownTime += numStepped;
+        if (frame !== null) showLiveFrame(frame);
+        if (numStepped === 0 || frame === null) stopLive();
+    } catch (err) {
+        if (live.writer === writer) stopLive();
+        showLiveError(err);
+    } finally {
+        live.isStepping = false;
+    }
+}
+
+// starts a live simulation with the settings, submits the process table to it and steps it at the playback speed
+async function startLive() {
+
+    try {
+
+        // the worker's memory is shared with this page, which browsers only allow on cross-origin isolated pages
+        if (!crossOriginIsolated)
+            throw new Error('Live simulations need a cross-origin isolated page (SharedArrayBuffer is unavailable)');
+
+        // validate settings and table
+        const { numCpus, algType, rrQuantum } = getSettings();
+        const processes = getSortedProcesses().sort((a, b) => a.start_time - b.start_time);
+
+        // replace any shown run or live simulation
+        pausePlayback();
+        stopLive();
+        playback.readFrame = null;
+        seekInput.disabled = true;
+
+        // start simulation with a ring that holds the whole table, and submit it (the first step takes it all)
+        const ringCapacity = Math.min(Math.max(processes.length, MIN_LIVE_RING_CAPACITY), MAX_RING_CAPACITY);
+        const { memory, ringPtr } = await requestWorker({ live: { numCpus, alg: algType, rrQuantum, ringCapacity } });
+        const writer = createRingWriter(memory, ringPtr);
+        for (const obj of processes)
+            writer.push(obj.pid, obj.start_time, obj.duration);
+        Object.assign(live, { writer, shownTime: 0, time: 0, lastTimestamp: null, isStepping: false, isClosed: false });
 
         // successful; remove error feedback if present
         simErrP.textContent = '';
         simErrDiv.style.display = 'none';
+        injectBtn.disabled = false;
+        closeLiveBtn.disabled = false;
 
-        // get frames
-        const frames = cRetStr.split('\n');
-        console.log(frames);
+        // show the first second, then step
+        const { frame } = await requestWorker({ liveStep: 0 });
+        if (live.writer !== writer) return;
+        if (frame !== null) showLiveFrame(frame);
+        live.animationId = requestAnimationFrame(stepLive);
 
-        for (let i = 0; i < frames.length - 1; i++) {
-            setTimeout(() => {
+    // handle custom throws
+    } catch (err) {
 
-                // parse frame (first element = queue size, rest are processes)
-                const unparsedProcesses = frames[i].split(';');
+        stopLive();
+        showLiveError(err);
+    }
+}
 
-                // set text to queue size
-                queueSizeP.textContent = `Queue Size: ${unparsedProcesses[0]}`;
+// submits one process to the running live simulation (one starting in a second already shown starts at the next one)
+function injectProcess() {
+
+    try {
+        const pid = document.querySelector('input#livePid').valueAsNumber;
+        const duration = document.querySelector('input#liveDuration').valueAsNumber;
+        if (!Number.isInteger(pid) || pid < 0 || pid > MAX_TIME_AND_PID || !Number.isInteger(duration) || duration < 0 || duration > MAX_TIME_AND_PID)
+            throw new Error(`Live process validation failed - process IDs and durations must be 0-${MAX_TIME_AND_PID}`);
+        if (live.writer === null || live.isClosed)
+            throw new Error('No live simulation is taking processes');
+        if (!live.writer.push(pid, live.shownTime + 1, duration))
+            throw new Error('Live ring is full - try again once the simulation has taken its processes');
+    } catch (err) {
+        showLiveError(err);
+    }
+}
 
-                // iterate through processes and set table
-                let processes = [];
-                for (let j = 1; j < unparsedProcesses.length - 1; j++) {
-                    const processFields = unparsedProcesses[j].split(',');
-                    processes.push({ pid: processFields[0], remaining_time: processFields[1] });
-                    console.log({ pid: processFields[0], remaining_time: processFields[1] })
-                }
-                liveTable.setData(processes);
+// no more processes (the live simulation then runs until every submitted process is done)
+function closeLive() {
 
-            }, 1000 * i);
-        }
+    if (live.writer === null || live.isClosed) return;
+    live.writer.close();
+    live.isClosed = true;
+    injectBtn.disabled = true;
+    closeLiveBtn.disabled = true;
+}
+
+liveBtn.addEventListener('click', startLive);
+injectBtn.addEventListener('click', injectProcess);
+closeLiveBtn.addEventListener('click', closeLive);
+
+
+
+/**************************************************/
+/* Parameter Sweep                                */
+/**************************************************/
+
+// sweep error feedback elements
+const sweepErrDiv = document.querySelector('div#sweepErr');
+const sweepErrP = document.querySelector('div#sweepErr > p');
+
+// doubles per sweep row (alg, numCpus, rrQuantum, then 7 metrics and 3 summaries of 5; see procsweep.h and procstats.h)
+const SWEEP_ROW_LENGTH = 25;
 
-        // free returned string
-        _free(cRetStr);
+// setup sweep table (one row per configuration)
+const sweepTable = new Tabulator('#sweep-table', {
+    height: 300,
+    data: [],
+    layout: 'fitColumns',
+    columns: [
+        { title: 'Algorithm', field: 'alg' },
+        { title: 'CPUs', field: 'cpus' },
+        { title: 'Quantum (s)', field: 'quantum' },
+        { title: 'Avg Wait (s)', field: 'avg_wait' },
+        { title: 'P99 Wait (s)', field: 'p99_wait' },
+        { title: 'Avg Turnaround (s)', field: 'avg_turnaround' },
+        { title: 'P99 Turnaround (s)', field: 'p99_turnaround' },
+        { title: 'Avg Response (s)', field: 'avg_response' },
+        { title: 'CPU Utilization', field: 'utilization' },
+        { title: 'Throughput (/s)', field: 'throughput' },
+        { title: 'Context Switches', field: 'context_switches' }
+    ]
+});
+
+// sweep worker (started on first use; runs the threaded sweep module off the page, see sweep-worker.mjs)
+let sweepWorker = null;
+const pendingSweeps = new Map(); // sweep id -> { resolve, reject }
+let nextSweepId = 0;
+
+// runs a sweep in the worker; resolves with its row count and rows (SWEEP_ROW_LENGTH doubles each)
+function requestSweep(paramStr) {
+
+    // start worker, settling sweeps as replies arrive
+    if (sweepWorker === null) {
+        sweepWorker = new Worker('/scripts/sweep-worker.mjs', { type: 'module' });
+        sweepWorker.onmessage = ({ data }) => {
+            const pendingSweep = pendingSweeps.get(data.id);
+            pendingSweeps.delete(data.id);
+            if (data.rows === undefined)
+                pendingSweep.reject(new Error(data.errorCode ? ENGINE_ERRORS[data.errorCode] : 'Could not run sweep'));
+            else pendingSweep.resolve(data);
+        };
+
+        // a failed worker fails every sweep (the next one starts a new worker)
+        sweepWorker.onerror = event => {
+            const err = new Error(`Sweep worker failed - ${event.message ?? 'could not load sweep module'}`);
+            pendingSweeps.forEach(pendingSweep => pendingSweep.reject(err));
+            pendingSweeps.clear();
+            sweepWorker.terminate();
+            sweepWorker = null;
+        };
+    }
+
+    // post sweep
+    const id = nextSweepId++;
+    return new Promise((resolve, reject) => {
+        pendingSweeps.set(id, { resolve, reject });
+        sweepWorker.postMessage({ id, paramStr });
+    });
+}
+
+async function runSweep() {
+
+    // wrap all with try
+    try {
+
+        // threads share memory, which browsers only allow on cross-origin isolated pages
+        if (!crossOriginIsolated)
+            throw new Error('Parameter sweeps need a cross-origin isolated page (SharedArrayBuffer is unavailable)');
+
+        // validate ranges
+        const minCpus = document.querySelector('input#sweepMinCpus').valueAsNumber;
+        const maxCpus = document.querySelector('input#sweepMaxCpus').valueAsNumber;
+        const minQuantum = document.querySelector('input#sweepMinQuantum').valueAsNumber;
+        const maxQuantum = document.querySelector('input#sweepMaxQuantum').valueAsNumber;
+        if (!Number.isInteger(minCpus) || !Number.isInteger(maxCpus) || minCpus < 1 || minCpus > maxCpus || maxCpus > MAX_NUM_CPUS ||
+            !Number.isInteger(minQuantum) || !Number.isInteger(maxQuantum) || minQuantum < 1 || minQuantum > maxQuantum || maxQuantum > MAX_TIME_AND_PID)
+            throw new Error(`Sweep settings validation failed - CPUs must be 1-${MAX_NUM_CPUS} and round robin times 1-${MAX_TIME_AND_PID}, with min no greater than max`);
+        else if ((maxCpus - minCpus + 1) * (NUM_ALGS - NUM_QUANTUM_ALGS + NUM_QUANTUM_ALGS * (maxQuantum - minQuantum + 1)) > MAX_SWEEP_CONFIGS)
+            throw new Error(`Sweep settings validation failed - there may not be more than ${MAX_SWEEP_CONFIGS} configurations`);
+
+        // generate param string to hand to wasm
+        const paramStr = `${minCpus},${maxCpus},${minQuantum},${maxQuantum},` + getProcessParamStr();
+
+        // run on one thread per core in the sweep worker (the button stays disabled until it finishes)
+        sweepBtn.disabled = true;
+        const { numRows, rows: rowData } = await requestSweep(paramStr);
+
+        // successful; remove error feedback if present
+        sweepErrP.textContent = '';
+        sweepErrDiv.style.display = 'none';
+
+        // read table
+        let rows = [];
+        for (let i = 0; i < numRows; i++) {
+            const row = rowData.subarray(i * SWEEP_ROW_LENGTH, (i + 1) * SWEEP_ROW_LENGTH);
+            rows.push({
+                alg: ALG_NAMES[row[0]],
+                cpus: row[1],
+                quantum: usesQuantum(row[0]) ? row[2] : '-',
+                avg_wait: row[10].toFixed(2),
+                p99_wait: row[13],
+                avg_turnaround: row[15].toFixed(2),
+                p99_turnaround: row[18],
+                avg_response: row[20].toFixed(2),
+                utilization: row[6].toFixed(3),
+                throughput: row[7].toFixed(3),
+                context_switches: row[8]
+            });
+        }
+        sweepTable.setData(rows);
 
     // handle custom throws
     } catch (err) {
 
         console.error(err);
-        simErrP.textContent = err?.message;
-        simErrDiv.style.display = 'block';
-        return;
+        sweepErrP.textContent = err?.message;
+        sweepErrDiv.style.display = 'block';
     }
+    sweepBtn.disabled = false;
 }
 
-document.querySelector('button#start-btn').addEventListener('click', displayFrames);
-
+const sweepBtn = document.querySelector('button#sweep-btn');
+sweepBtn.addEventListener('click', runSweep);
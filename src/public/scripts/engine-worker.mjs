@@ -0,0 +1,124 @@
+// This module runs the engine in a dedicated worker, so simulations never block the page.
+// Requests are { id, input } (input = SimConfig words followed by (pid, start, duration) words, transferred).
+// Replies are { id, result: { numCpus, numFrames, intervals, queuePoints }, stats } with the interval arrays transferred, or { id, errorCode }.
+// A seeded synthetic workload is generated and run inside the engine with { id, generate } (generate = SimConfig words followed by GenParams words; see procgen.h), with the same replies.
+// A live simulation is started with { id, live: { numCpus, alg, rrQuantum, ringCapacity } }, which replies { id, memory, ringPtr } for a ring writer (see procring.mjs).
+// { id, liveStep: numFrames } then steps it and replies { id, numStepped, frame } (liveStep 0 only starts it and reads its first frame; numStepped is 0 once the ring is closed and every process is done; frame is null if there were none).
+
+import createEngineModule from '/webasm/procmgr.mjs';
+import { INTERVAL_WORDS, QUEUE_POINT_WORDS } from './intervals.mjs';
+
+// SimConfig words (numCpus, alg, rrQuantum; see procmgr.h)
+const SIM_CONFIG_WORDS = 3;
+
+// IntervalBuffer header words read here (data pointer, numIntervals, queue points pointer, numQueuePoints, numCpus, numFrames; see intervalbuf.h)
+const INTERVAL_BUFFER_WORDS = 6;
+
+// engine statistics in struct order (see EngineStats in procmgr.h)
+const ENGINE_STAT_NAMES = ['allocations', 'nodeMoves', 'queueScans', 'framesEmitted', 'events', 'arrivalSeconds', 'tickSeconds', 'dispatchSeconds', 'frameSeconds'];
+
+// engine errors used here (see SpmErrors in procmgr.h)
+const SPM_ERR_INPUT = 1;
+const SPM_ERR_MEMORY = 4;
+
+const engine = await createEngineModule();
+
+// re-simulation session (kept across runs, so a run after a table edit only recomputes from the last checkpoint before the edit)
+const simSession = engine._spmSessionCreate();
+
+// live simulation handle (0 if none) and its words per frame
+let liveHandle = 0;
+let liveFrameLength = 0;
+
+// reads the engine statistics of the last finished simulation
+function getEngineStats() {
+
+    const statsPtr = engine._spmGetStats();
+    const stats = engine.HEAPF64.subarray(statsPtr >> 3, (statsPtr >> 3) + ENGINE_STAT_NAMES.length);
+    return Object.fromEntries(ENGINE_STAT_NAMES.map((name, i) => [name, stats[i]]));
+}
+
+// runs the session on an engine input; returns [reply, transfer list]
+function runSession(id, input) {
+
+    // copy input into WASM memory
+    const inputPtr = engine._malloc(input.byteLength);
+    if (inputPtr === 0) return [{ id, errorCode: SPM_ERR_MEMORY }, []];
+    engine.HEAPU32.set(input, inputPtr >> 2);
+
+    // run (the interval buffer belongs to the session)
+    const numProcesses = (input.length - SIM_CONFIG_WORDS) / 3;
+    const intervalsPtr = engine._spmSessionRunArray(simSession, inputPtr, inputPtr + 4 * SIM_CONFIG_WORDS, numProcesses);
+    engine._free(inputPtr);
+    if (intervalsPtr === 0) return [{ id, errorCode: engine._spmGetError() }, []];
+    return getIntervalReply(id, intervalsPtr);
+}
+
+// generates a workload in the engine and runs it (without the session, since nothing is shared between generated runs); returns [reply, transfer list]
+function runGenerated(id, words) {
+
+    const wordsPtr = engine._malloc(words.byteLength);
+    if (wordsPtr === 0) return [{ id, errorCode: SPM_ERR_MEMORY }, []];
+    engine.HEAPU32.set(words, wordsPtr >> 2);
+    const intervalsPtr = engine._getGeneratedIntervalData(wordsPtr, wordsPtr + 4 * SIM_CONFIG_WORDS);
+    engine._free(wordsPtr);
+    if (intervalsPtr === 0) return [{ id, errorCode: engine._spmGetError() }, []];
+    const reply = getIntervalReply(id, intervalsPtr);
+    engine._freeIntervalData(intervalsPtr);
+    return reply;
+}
+
+// copies a finished run's interval buffer into a reply; returns [reply, transfer list]
+function getIntervalReply(id, intervalsPtr) {
+
+    // copy intervals and queue points (the views are taken after the run since growing WASM memory replaces HEAPU32)
+    const heap = engine.HEAPU32;
+    const [dataPtr, numIntervals, queuePtr, numQueuePoints, numCpus, numFrames] = heap.subarray(intervalsPtr >> 2, (intervalsPtr >> 2) + INTERVAL_BUFFER_WORDS);
+    const intervals = heap.slice(dataPtr >> 2, (dataPtr >> 2) + numIntervals * INTERVAL_WORDS);
+    const queuePoints = heap.slice(queuePtr >> 2, (queuePtr >> 2) + numQueuePoints * QUEUE_POINT_WORDS);
+    return [{ id, result: { numCpus, numFrames, intervals, queuePoints }, stats: getEngineStats() }, [intervals.buffer, queuePoints.buffer]];
+}
+
+// replaces the live simulation with a new empty one; returns [reply, transfer list]
+function startLive(id, { numCpus, alg, rrQuantum, ringCapacity }) {
+
+    if (liveHandle !== 0) engine._spmDestroy(liveHandle);
+    liveHandle = 0;
+
+    // write settings and create simulation
+    const configPtr = engine._malloc(4 * SIM_CONFIG_WORDS);
+    if (configPtr === 0) return [{ id, errorCode: SPM_ERR_MEMORY }, []];
+    engine.HEAPU32.set([numCpus, alg, rrQuantum], configPtr >> 2);
+    liveHandle = engine._spmCreateLive(configPtr, ringCapacity);
+    engine._free(configPtr);
+    if (liveHandle === 0) return [{ id, errorCode: engine._spmGetError() }, []];
+    liveFrameLength = 1 + 2 * numCpus;
+
+    // the memory is shared, so the page writes the ring in place
+    return [{ id, memory: engine.wasmMemory, ringPtr: engine._spmGetRing(liveHandle) }, []];
+}
+
+// steps the live simulation (taking new submissions every second); returns [reply, transfer list]
+function stepLive(id, numFrames) {
+
+    if (liveHandle === 0) return [{ id, errorCode: SPM_ERR_INPUT }, []];
+    const numStepped = engine._spmStep(liveHandle, numFrames);
+    if (numStepped < 0) return [{ id, errorCode: engine._spmGetError() }, []];
+
+    // a ring closed before any process was submitted has no frames
+    const framePtr = engine._spmReadFrame(liveHandle);
+    if (framePtr === 0) return [{ id, numStepped: 0, frame: null }, []];
+    const frame = engine.HEAPU32.slice(framePtr >> 2, (framePtr >> 2) + liveFrameLength);
+    return [{ id, numStepped, frame }, [frame.buffer]];
+}
+
+self.onmessage = ({ data }) => {
+    const [reply, transfer] = data.live !== undefined ? startLive(data.id, data.live) :
+        data.liveStep !== undefined ? stepLive(data.id, data.liveStep) :
+        data.generate !== undefined ? runGenerated(data.id, data.generate) :
+        runSession(data.id, data.input);
+    self.postMessage(reply, transfer);
+};
+
+// ready once the engine is loaded (messages sent before then could arrive with no handler)
+self.postMessage({ ready: true });
@@ -0,0 +1,67 @@
+// This module rebuilds per-second frames from a run's execution intervals (see intervalbuf.h) as they are shown.
+// A run is kept as { numCpus, numFrames, intervals, queuePoints }, which grows with the context switches rather than the simulated seconds.
+
+// interval words (cpu, pid, start, end, remaining time at start) and queue length change words (time, queue size)
+export const INTERVAL_WORDS = 5;
+export const QUEUE_POINT_WORDS = 2;
+
+// pid written to unused CPU slots
+export const IDLE_CPU_PID = 0xFFFFFFFF;
+
+// returns the last index in [0, count) whose key is at most 'time' (keys ascend); -1 if there is none
+function findLastAtOrBefore(count, getKey, time) {
+
+    let low = 0;
+    let high = count;
+    while (low < high) {
+        const mid = (low + high) >>> 1;
+        if (getKey(mid) <= time) low = mid + 1;
+        else high = mid;
+    }
+    return low - 1;
+}
+
+// returns readFrame(time), which rebuilds the frame at a second in the binary frame layout ([queue_size] [pid, remaining_time] * numCpus)
+export function createFrameReader({ numCpus, intervals, queuePoints }) {
+
+    // group interval indexes by CPU (a CPU's intervals never overlap, so they are in start order)
+    const numIntervals = intervals.length / INTERVAL_WORDS;
+    const cpuOffsets = new Uint32Array(numCpus + 1);
+    for (let i = 0; i < numIntervals; i++)
+        cpuOffsets[intervals[i * INTERVAL_WORDS] + 1]++;
+    for (let cpu = 0; cpu < numCpus; cpu++)
+        cpuOffsets[cpu + 1] += cpuOffsets[cpu];
+    const cpuIntervals = new Uint32Array(numIntervals);
+    const nextSlot = cpuOffsets.slice(0, numCpus);
+    for (let i = 0; i < numIntervals; i++)
+        cpuIntervals[nextSlot[intervals[i * INTERVAL_WORDS]]++] = i;
+
+    return time => {
+
+        // queue size from the last change at or before the second
+        const frame = new Uint32Array(1 + 2 * numCpus);
+        const point = findLastAtOrBefore(queuePoints.length / QUEUE_POINT_WORDS, i => queuePoints[i * QUEUE_POINT_WORDS], time);
+        frame[0] = point < 0 ? 0 : queuePoints[point * QUEUE_POINT_WORDS + 1];
+
+        // on each CPU, the last interval started by then is running if it has not ended
+        const running = [];
+        for (let cpu = 0; cpu < numCpus; cpu++) {
+            const first = cpuOffsets[cpu];
+            const last = findLastAtOrBefore(cpuOffsets[cpu + 1] - first, i => intervals[cpuIntervals[first + i] * INTERVAL_WORDS + 2], time);
+            if (last >= 0 && intervals[cpuIntervals[first + last] * INTERVAL_WORDS + 3] > time)
+                running.push(cpuIntervals[first + last]);
+        }
+
+        // frames list running processes in dispatch order, i.e. interval order (the rest of the CPUs are idle)
+        running.sort((a, b) => a - b);
+        for (let j = 0; j < numCpus; j++) {
+            if (j < running.length) {
+                const interval = running[j] * INTERVAL_WORDS;
+                frame[1 + 2 * j] = intervals[interval + 1];
+                frame[2 + 2 * j] = intervals[interval + 4] - (time - intervals[interval + 2]);
+            } else
+                frame[1 + 2 * j] = IDLE_CPU_PID;
+        }
+        return frame;
+    };
+}
@@ -0,0 +1,9 @@
+// Type declarations for the limits module generated by build.sh from src/public/webasm/spmlimits.h.
+
+export declare const MAX_NUM_CPUS: number;
+export declare const MAX_TIME_AND_PID: number;
+export declare const MAX_PROCESSES: number;
+export declare const NUM_ALGS: number;
+export declare const NUM_QUANTUM_ALGS: number;
+export declare const MAX_FRAME_DATA_BYTES: number;
+export declare const SPM_OUTPUT_VERSION: number;
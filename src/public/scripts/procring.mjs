@@ -0,0 +1,45 @@
+// This module submits processes to a live simulation's ring (see procring.h) by writing the engine's shared WASM memory directly.
+// It is the ring's single producer: one page or worker may write a ring while the engine worker steps the simulation, with no messages per process.
+
+// entry format ([pid] [start_time] [duration]) and header word offsets (slots pointer, mask, closed flag; see ProcessRing)
+export const RING_ENTRY_WORDS = 3;
+const RING_SLOTS_WORD = 0;
+const RING_MASK_WORD = 1;
+const RING_CLOSED_WORD = 2;
+const RING_HEAD_WORD = 16;
+const RING_TAIL_WORD = 32;
+
+// returns { push(pid, startTime, duration) (false if the ring is full), close() } for a ring in a shared WebAssembly.Memory
+export function createRingWriter(memory, ringPtr) {
+
+    // views are taken per call, since growing shared memory exposes a longer buffer
+    const header = ringPtr >> 2;
+    const getHeap = () => new Uint32Array(memory.buffer);
+    const initialHeap = getHeap();
+    const slots = initialHeap[header + RING_SLOTS_WORD] >> 2;
+    const mask = initialHeap[header + RING_MASK_WORD];
+
+    return {
+        push(pid, startTime, duration) {
+
+            // full if the engine has not freed the slot one lap back
+            const heap = getHeap();
+            const tail = Atomics.load(heap, header + RING_TAIL_WORD);
+            if (((tail - Atomics.load(heap, header + RING_HEAD_WORD)) >>> 0) > mask) return false;
+
+            // write entry, then publish it
+            const entry = slots + RING_ENTRY_WORDS * ((tail & mask) >>> 0);
+            heap[entry] = pid;
+            heap[entry + 1] = startTime;
+            heap[entry + 2] = duration;
+            Atomics.store(heap, header + RING_TAIL_WORD, (tail + 1) >>> 0);
+            return true;
+        },
+
+        // no more processes (the simulation finishes once every submitted one is done)
+        close() {
+
+            Atomics.store(getHeap(), header + RING_CLOSED_WORD, 1);
+        }
+    };
+}
@@ -0,0 +1,97 @@
+// This module caches finished simulations in IndexedDB, keyed by a SHA-256 hash of the engine output version and the engine input.
+// The input holds the settings and the process set in pid order, so any change to the table is a new key; entries outlive deployments, so an engine whose output changed (a new SPM_OUTPUT_VERSION) never hits the old ones.
+
+import { SPM_OUTPUT_VERSION } from './limits.mjs';
+
+const CACHE_DB_NAME = 'spm-cache';
+const CACHE_DB_VERSION = 3;   // version 1 stored per-second frames, version 2 keys without the output version
+const RUNS_STORE = 'runs';     // { key, numCpus, numFrames, intervals, queuePoints }
+const USAGE_STORE = 'usage';   // { key, bytes, lastUsed } (kept apart so eviction does not load runs)
+
+// least recently used results are evicted past this many bytes
+export const MAX_CACHE_BYTES = 256 * 1024 * 1024;
+
+// database connection (opened on first use)
+let cacheDbPromise = null;
+
+// resolves with a request's result
+function getRequestResult(request) {
+    return new Promise((resolve, reject) => {
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+    });
+}
+
+function openCacheDb() {
+
+    cacheDbPromise ??= new Promise((resolve, reject) => {
+        const request = indexedDB.open(CACHE_DB_NAME, CACHE_DB_VERSION);
+        request.onupgradeneeded = () => {
+
+            // entries from older versions are dropped rather than converted
+            for (const storeName of Array.from(request.result.objectStoreNames))
+                request.result.deleteObjectStore(storeName);
+            request.result.createObjectStore(RUNS_STORE, { keyPath: 'key' });
+            request.result.createObjectStore(USAGE_STORE, { keyPath: 'key' }).createIndex('lastUsed', 'lastUsed');
+        };
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+    });
+    return cacheDbPromise;
+}
+
+// returns the hex SHA-256 digest of the output version and an engine input's words (copied when called, so a view of WASM memory may be passed)
+export async function getCacheKey(input) {
+
+    const words = new Uint32Array(1 + input.length);
+    words[0] = SPM_OUTPUT_VERSION;
+    words.set(input, 1);
+    const digest = await crypto.subtle.digest('SHA-256', words);
+    return Array.from(new Uint8Array(digest), byte => byte.toString(16).padStart(2, '0')).join('');
+}
+
+// returns { numCpus, numFrames, intervals, queuePoints (Uint32Arrays) } for a key, or undefined on a miss
+export async function getCachedRun(key) {
+
+    const cacheDb = await openCacheDb();
+    const transaction = cacheDb.transaction([RUNS_STORE, USAGE_STORE], 'readwrite');
+    const entry = await getRequestResult(transaction.objectStore(RUNS_STORE).get(key));
+    if (entry === undefined) return undefined;
+
+    // mark as most recently used
+    transaction.objectStore(USAGE_STORE).put({ key, bytes: entry.intervals.byteLength + entry.queuePoints.byteLength, lastUsed: Date.now() });
+    return { numCpus: entry.numCpus, numFrames: entry.numFrames, intervals: new Uint32Array(entry.intervals), queuePoints: new Uint32Array(entry.queuePoints) };
+}
+
+// stores the intervals of a finished simulation, evicting least recently used results past the byte budget
+export async function putCachedRun(key, { numCpus, numFrames, intervals, queuePoints }) {
+
+    const bytes = intervals.byteLength + queuePoints.byteLength;
+    if (bytes > MAX_CACHE_BYTES) return;
+
+    const cacheDb = await openCacheDb();
+    const transaction = cacheDb.transaction([RUNS_STORE, USAGE_STORE], 'readwrite');
+    const runsStore = transaction.objectStore(RUNS_STORE);
+    const usageStore = transaction.objectStore(USAGE_STORE);
+    runsStore.put({ key, numCpus, numFrames, intervals: intervals.buffer, queuePoints: queuePoints.buffer });
+    usageStore.put({ key, bytes, lastUsed: Date.now() });
+
+    // walk from the newest entry and drop everything once the budget is used up
+    let totalBytes = 0;
+    const cursorRequest = usageStore.index('lastUsed').openCursor(null, 'prev');
+    cursorRequest.onsuccess = () => {
+        const cursor = cursorRequest.result;
+        if (cursor === null) return;
+        totalBytes += cursor.value.bytes;
+        if (totalBytes > MAX_CACHE_BYTES) {
+            runsStore.delete(cursor.value.key);
+            cursor.delete();
+        }
+        cursor.continue();
+    };
+
+    return new Promise((resolve, reject) => {
+        transaction.oncomplete = () => resolve();
+        transaction.onerror = () => reject(transaction.error);
+    });
+}
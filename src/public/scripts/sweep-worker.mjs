@@ -0,0 +1,37 @@
+// This module runs parameter sweeps in a dedicated worker, so the threaded sweep (which joins its threads by waiting on them) never blocks the page.
+// Requests are { id, paramStr } (minCpus,maxCpus,minQuantum,maxQuantum,pid,start,duration,...; see procsweep.c).
+// Replies are { id, numRows, rows } with the rows' doubles (SWEEP_ROW_LENGTH per configuration) transferred, or { id, errorCode }.
+
+import createSweepModule from '/webasm/procsweep.mjs';
+
+// doubles per sweep row (alg, numCpus, rrQuantum, then 7 metrics and 3 summaries of 5; see procsweep.h and procstats.h)
+const SWEEP_ROW_LENGTH = 25;
+
+// engine errors used here (see SpmErrors in procmgr.h)
+const SPM_ERR_MEMORY = 4;
+
+// loading starts now, but requests are handled as they arrive (a handler set after an await could miss them)
+const sweepModulePromise = createSweepModule();
+
+// runs one sweep on one thread per core; returns [reply, transfer list]
+function runSweep(sweepModule, id, paramStr) {
+
+    // run (param string and table must be freed)
+    const cParamStr = sweepModule.stringToNewUTF8(paramStr);
+    if (cParamStr === 0) return [{ id, errorCode: SPM_ERR_MEMORY }, []];
+    const tablePtr = sweepModule._getSweep(cParamStr, 0);
+    sweepModule._free(cParamStr);
+    if (tablePtr === 0) return [{ id, errorCode: sweepModule._spmGetError() }, []];
+
+    // copy rows (first double = row count; the view is taken after the run since threads may have grown memory)
+    const heap = new Float64Array(sweepModule.wasmMemory.buffer);
+    const numRows = heap[tablePtr >> 3];
+    const rows = heap.slice((tablePtr >> 3) + 1, (tablePtr >> 3) + 1 + numRows * SWEEP_ROW_LENGTH);
+    sweepModule._free(tablePtr);
+    return [{ id, numRows, rows }, [rows.buffer]];
+}
+
+self.onmessage = async ({ data }) => {
+    const [reply, transfer] = runSweep(await sweepModulePromise, data.id, data.paramStr);
+    self.postMessage(reply, transfer);
+};
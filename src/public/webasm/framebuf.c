@@ -0,0 +1,40 @@
+#include "framebuf.h"
+#include <stdlib.h>
+
+// returns null on allocation failure
+FrameBuffer* createFrameBuffer(unsigned int numCpus) {
+
+    // init new empty frame buffer
+    FrameBuffer* frameBuf = malloc(sizeof(FrameBuffer));
+    if (frameBuf == NULL) return NULL;
+    *frameBuf = (FrameBuffer){ .data = NULL, .size = 0, .capacity = 0, .stride = 1 + 2 * numCpus, .numFrames = 0 };
+    return frameBuf;
+}
+
+unsigned int* reserveFrame(FrameBuffer* frameBuf) {
+
+    // grow data (geometrically) if next frame does not fit
+    if (frameBuf->size + frameBuf->stride > frameBuf->capacity) {
+        unsigned int capacity = frameBuf->capacity ? frameBuf->capacity * 2 : frameBuf->stride * 64;
+        while (capacity < frameBuf->size + frameBuf->stride)
+            capacity *= 2;
+        unsigned int* data = realloc(frameBuf->data, sizeof(unsigned int) * capacity);
+        if (data == NULL) return NULL;
+        frameBuf->data = data;
+        frameBuf->capacity = capacity;
+    }
+
+    // claim frame
+    unsigned int* frame = frameBuf->data + frameBuf->size;
+    frameBuf->size += frameBuf->stride;
+    frameBuf->numFrames++;
+    return frame;
+}
+
+void freeFrameBuffer(FrameBuffer* frameBuf) {
+
+    // free data and header
+    if (frameBuf == NULL) return;
+    free(frameBuf->data);
+    free(frameBuf);
+}
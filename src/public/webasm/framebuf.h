@@ -0,0 +1,29 @@
+// This header file represents a growable buffer of binary frames.
+// Frames are packed as unsigned 32-bit words so they can be viewed directly from JS (HEAPU32) without any string parsing.
+
+#ifndef FRAMEBUF_H
+#define FRAMEBUF_H
+
+// pid written to unused CPU slots
+#define IDLE_CPU_PID 0xFFFFFFFFu
+
+// frame format (stride = 1 + 2 * numCpus words):
+// [queue_size] [pid, remaining_time] * numCpus
+typedef struct FrameBuffer {
+
+    // header (field order is read by index from JS; do not reorder)
+    unsigned int* data;
+    unsigned int size;      // number of words written
+    unsigned int capacity;  // number of words allocated
+    unsigned int stride;    // number of words per frame
+    unsigned int numFrames;
+
+} FrameBuffer;
+
+FrameBuffer* createFrameBuffer(unsigned int numCpus);
+
+unsigned int* reserveFrame(FrameBuffer* frameBuf); // returns pointer to next frame's words (null on allocation failure)
+
+void freeFrameBuffer(FrameBuffer* frameBuf);
+
+#endif
@@ -0,0 +1,93 @@
+#include "intervalbuf.h"
+#include "procrunq.h"
+#include <stdlib.h>
+
+// returns null on allocation failure
+IntervalBuffer* createIntervalBuffer(unsigned int numCpus) {
+
+    // init new empty interval buffer
+    IntervalBuffer* intervals = malloc(sizeof(IntervalBuffer));
+    if (intervals == NULL) return NULL;
+    *intervals = (IntervalBuffer){ .data = NULL, .numIntervals = 0, .queuePoints = NULL, .numQueuePoints = 0, .numCpus = numCpus, .numFrames = 0, .capacity = 0, .queueCapacity = 0 };
+
+    // every CPU starts free
+    intervals->freeMask = malloc(sizeof(unsigned long long) * ((numCpus + CPU_MASK_BITS - 1) / CPU_MASK_BITS));
+    if (intervals->freeMask == NULL) {
+        free(intervals);
+        return NULL;
+    }
+    resetFreeCpus(intervals);
+    return intervals;
+}
+
+unsigned int* reserveInterval(IntervalBuffer* intervals) {
+
+    // grow data (geometrically) if next interval does not fit
+    if (intervals->numIntervals == intervals->capacity) {
+        unsigned int capacity = intervals->capacity ? intervals->capacity * 2 : 64;
+        unsigned int* data = realloc(intervals->data, sizeof(unsigned int) * INTERVAL_WORDS * capacity);
+        if (data == NULL) return NULL;
+        intervals->data = data;
+        intervals->capacity = capacity;
+    }
+
+    // claim interval
+    return intervals->data + INTERVAL_WORDS * intervals->numIntervals++;
+}
+
+int addQueuePoint(IntervalBuffer* intervals, unsigned int time, unsigned int queueSize) {
+
+    // only changes are kept
+    if (intervals->numQueuePoints > 0 && intervals->queuePoints[QUEUE_POINT_WORDS * (intervals->numQueuePoints - 1) + 1] == queueSize)
+        return 0;
+
+    // grow points (geometrically) if next point does not fit
+    if (intervals->numQueuePoints == intervals->queueCapacity) {
+        unsigned int capacity = intervals->queueCapacity ? intervals->queueCapacity * 2 : 64;
+        unsigned int* queuePoints = realloc(intervals->queuePoints, sizeof(unsigned int) * QUEUE_POINT_WORDS * capacity);
+        if (queuePoints == NULL) return 1;
+        intervals->queuePoints = queuePoints;
+        intervals->queueCapacity = capacity;
+    }
+
+    // add point
+    unsigned int* point = intervals->queuePoints + QUEUE_POINT_WORDS * intervals->numQueuePoints++;
+    point[0] = time;
+    point[1] = queueSize;
+    return 0;
+}
+
+// with the global queue, intervals are placed on the lowest free CPU (a process keeps it until it leaves)
+unsigned int claimFreeCpu(IntervalBuffer* intervals) {
+
+    unsigned int cpu = findNextCpu(intervals->freeMask, intervals->numCpus, 0);
+    claimCpu(intervals, cpu);
+    return cpu;
+}
+
+void claimCpu(IntervalBuffer* intervals, unsigned int cpu) {
+
+    intervals->freeMask[cpu / CPU_MASK_BITS] &= ~(1ull << (cpu % CPU_MASK_BITS));
+}
+
+void releaseCpu(IntervalBuffer* intervals, unsigned int cpu) {
+
+    intervals->freeMask[cpu / CPU_MASK_BITS] |= 1ull << (cpu % CPU_MASK_BITS);
+}
+
+void resetFreeCpus(IntervalBuffer* intervals) {
+
+    unsigned int numWords = (intervals->numCpus + CPU_MASK_BITS - 1) / CPU_MASK_BITS;
+    for (unsigned int word = 0; word < numWords; word++)
+        intervals->freeMask[word] = ~0ull;
+}
+
+void freeIntervalBuffer(IntervalBuffer* intervals) {
+
+    // free data, points and header
+    if (intervals == NULL) return;
+    free(intervals->data);
+    free(intervals->queuePoints);
+    free(intervals->freeMask);
+    free(intervals);
+}
@@ -0,0 +1,44 @@
+// This header file represents a growable buffer of execution intervals: a run-length alternative to per-second frames.
+// Only dispatches, completions and queue length changes are written, so the output grows with the context switches rather than the simulated seconds.
+
+#ifndef INTERVALBUF_H
+#define INTERVALBUF_H
+
+// interval format (in dispatch order): [cpu] [pid] [start] [end] [remaining_time at start]
+// the frame at second t lists the intervals with start <= t < end in this order, each with remaining time 'remaining - (t - start)'
+#define INTERVAL_WORDS 5
+
+// queue length change format (in time order): [time] [queue_size]
+#define QUEUE_POINT_WORDS 2
+
+// end of an interval that is still running (times must stay below it)
+#define INTERVAL_OPEN 0xFFFFFFFFu
+
+typedef struct IntervalBuffer {
+
+    // header (field order is read by index from JS; do not reorder)
+    unsigned int* data;           // intervals
+    unsigned int numIntervals;
+    unsigned int* queuePoints;    // queue length change points (the first is at time 0)
+    unsigned int numQueuePoints;
+    unsigned int numCpus;
+    unsigned int numFrames;       // seconds the run spans (the frames it stands for)
+
+    unsigned int capacity;        // intervals allocated
+    unsigned int queueCapacity;   // queue points allocated
+    unsigned long long* freeMask; // CPUs without a running interval (global queue only; bit set = free)
+
+} IntervalBuffer;
+
+IntervalBuffer* createIntervalBuffer(unsigned int numCpus);
+
+unsigned int* reserveInterval(IntervalBuffer* intervals); // returns pointer to next interval's words (null on allocation failure)
+int addQueuePoint(IntervalBuffer* intervals, unsigned int time, unsigned int queueSize); // skipped if the size did not change; returns 1 on failure
+unsigned int claimFreeCpu(IntervalBuffer* intervals); // lowest free CPU, marked busy
+void claimCpu(IntervalBuffer* intervals, unsigned int cpu);
+void releaseCpu(IntervalBuffer* intervals, unsigned int cpu);
+void resetFreeCpus(IntervalBuffer* intervals);
+
+void freeIntervalBuffer(IntervalBuffer* intervals);
+
+#endif
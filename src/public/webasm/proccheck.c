@@ -0,0 +1,82 @@
+#include "proccheck.h"
+#include <stdlib.h>
+
+// returns null on allocation failure
+CheckpointList* createCheckpointList() {
+
+    CheckpointList* checkpointList = malloc(sizeof(CheckpointList));
+    if (checkpointList == NULL) return NULL;
+    checkpointList->size = 0;
+    checkpointList->interval = MIN_CHECKPOINT_INTERVAL;
+    checkpointList->numEvents = 0;
+    checkpointList->numBytes = 0;
+    return checkpointList;
+}
+
+// returns the snapshot bytes of a checkpoint
+static unsigned long long getCheckpointBytes(Checkpoint* checkpoint) {
+
+    return (unsigned long long)(checkpoint->numActive + checkpoint->numQueued) * sizeof(Process);
+}
+
+// keeps every other checkpoint (the oldest stays) and doubles the interval, so the rest of the run is covered just as sparsely
+static void thinCheckpoints(CheckpointList* checkpointList) {
+
+    unsigned int size = 0;
+    for (unsigned int i = 0; i < checkpointList->size; i++) {
+        if (i % 2 == 0) checkpointList->checkpoints[size++] = checkpointList->checkpoints[i];
+        else {
+            checkpointList->numBytes -= getCheckpointBytes(&checkpointList->checkpoints[i]);
+            free(checkpointList->checkpoints[i].processes);
+        }
+    }
+    checkpointList->size = size;
+    checkpointList->interval *= 2;
+}
+
+void addCheckpoint(CheckpointList* checkpointList, Checkpoint checkpoint) {
+
+    // the next checkpoint is counted from here either way
+    checkpointList->numEvents = 0;
+
+    // make room (by count and by bytes; thinning always keeps the oldest checkpoint)
+    unsigned long long numBytes = getCheckpointBytes(&checkpoint);
+    while (checkpointList->size > 1 &&
+        (checkpointList->size == MAX_CHECKPOINTS || checkpointList->numBytes + numBytes > MAX_CHECKPOINT_BYTES))
+        thinCheckpoints(checkpointList);
+
+    // skip a snapshot that still does not fit
+    if (checkpointList->numBytes + numBytes > MAX_CHECKPOINT_BYTES) {
+        free(checkpoint.processes);
+        return;
+    }
+
+    checkpointList->checkpoints[checkpointList->size++] = checkpoint;
+    checkpointList->numBytes += numBytes;
+}
+
+unsigned int findCheckpoint(CheckpointList* checkpointList, unsigned long long time) {
+
+    // checkpoints are in time order; search from the latest
+    for (unsigned int i = checkpointList->size; i > 0; i--)
+        if (checkpointList->checkpoints[i - 1].time < time)
+            return i - 1;
+    return checkpointList->size;
+}
+
+void truncateCheckpoints(CheckpointList* checkpointList, unsigned int size) {
+
+    while (checkpointList->size > size) {
+        Checkpoint* checkpoint = &checkpointList->checkpoints[--checkpointList->size];
+        checkpointList->numBytes -= getCheckpointBytes(checkpoint);
+        free(checkpoint->processes);
+    }
+    checkpointList->numEvents = 0;
+}
+
+void freeCheckpointList(CheckpointList* checkpointList) {
+
+    if (checkpointList == NULL) return;
+    truncateCheckpoints(checkpointList, 0);
+    free(checkpointList);
+}
@@ -0,0 +1,52 @@
+// This header file represents periodic snapshots of a process manager, taken between events while a run writes frames or intervals.
+// A later run whose input only differs from some start time on can resume from the last snapshot before it (see procresim.h).
+
+#ifndef PROCCHECK_H
+#define PROCCHECK_H
+
+#include "proclist.h"
+
+// at most this many checkpoints (and snapshot bytes) are kept; past either, every other one is dropped and the interval doubles
+#define MAX_CHECKPOINTS 64
+#define MAX_CHECKPOINT_BYTES (64 * 1024 * 1024)
+
+// events between checkpoints at the start of a run
+#define MIN_CHECKPOINT_INTERVAL 16
+
+// state right after an event was handled, before its frames were written (processes that had not arrived yet are not kept)
+typedef struct Checkpoint {
+
+    unsigned long long time;
+    unsigned long long prevTime;
+    unsigned long long numDecisions;
+    unsigned int frameSize;  // frame buffer words written before this event's frames
+    unsigned int numFrames;
+    unsigned int numIntervals;      // intervals opened up to this event (interval output)
+    unsigned int numQueuePoints;
+    unsigned int firstOpenInterval; // the running processes' intervals are the ones from here still running after this event (in running set order)
+    unsigned int numActive;  // running processes first (in running set order)
+    unsigned int numQueued;  // then queued processes (in queue order)
+    struct Process* processes;
+
+} Checkpoint;
+
+// checkpoints of one run, oldest first
+typedef struct CheckpointList {
+
+    struct Checkpoint checkpoints[MAX_CHECKPOINTS];
+    unsigned int size;
+    unsigned int interval;       // events between checkpoints
+    unsigned int numEvents;      // events since the last checkpoint
+    unsigned long long numBytes; // snapshot bytes over all checkpoints
+
+} CheckpointList;
+
+CheckpointList* createCheckpointList();
+
+void addCheckpoint(CheckpointList* checkpointList, Checkpoint checkpoint); // takes ownership of the snapshot (freed if it cannot be kept)
+unsigned int findCheckpoint(CheckpointList* checkpointList, unsigned long long time); // latest one before time; returns size if none
+void truncateCheckpoints(CheckpointList* checkpointList, unsigned int size); // drops checkpoints from index size on
+
+void freeCheckpointList(CheckpointList* checkpointList);
+
+#endif
@@ -0,0 +1,121 @@
+#include "procgen.h"
+#include "spmlimits.h"
+#include <math.h>
+
+// splitmix64 expands the seed into the xoshiro state (so nearby seeds give unrelated streams, and the state is never all zero)
+void seedGenRandom(GenRandom* random, unsigned long long seed) {
+
+    for (int i = 0; i < 4; i++) {
+        unsigned long long z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        random->state[i] = z ^ (z >> 31);
+    }
+}
+
+static inline unsigned long long rotateLeft(unsigned long long x, int k) {
+
+    return (x << k) | (x >> (64 - k));
+}
+
+// xoshiro256** (Blackman and Vigna)
+unsigned long long nextGenRandom(GenRandom* random) {
+
+    unsigned long long* s = random->state;
+    unsigned long long result = rotateLeft(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+    return result;
+}
+
+double nextGenUnit(GenRandom* random) {
+
+    return (nextGenRandom(random) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// duration in [1, GEN_MAX_DURATION]
+static unsigned int nextDuration(GenRandom* random, const GenParams* params) {
+
+    double mean = params->meanDuration;
+    double duration;
+    unsigned long long uniformDuration;
+    switch (params->durations) {
+        case DURATION_UNIFORM:
+            uniformDuration = 1 + nextGenRandom(random) % (2 * (unsigned long long)params->meanDuration - 1);
+            return uniformDuration < GEN_MAX_DURATION ? (unsigned int)uniformDuration : GEN_MAX_DURATION;
+        case DURATION_PARETO:
+            duration = mean / 3.0 / pow(1.0 - nextGenUnit(random), 1.0 / 1.5);
+            break;
+        default:
+            duration = -log(1.0 - nextGenUnit(random)) * mean + 0.5;
+            break;
+    }
+    if (duration < 1.0) return 1;
+    return duration < GEN_MAX_DURATION ? (unsigned int)duration : GEN_MAX_DURATION;
+}
+
+int generateProcesses(ProcessList* procList, unsigned int numCpus, const GenParams* params) {
+
+    // verify
+    if (params->arrivals >= NUM_ARRIVAL_PATTERNS || params->durations >= NUM_DURATION_DISTRIBUTIONS || params->meanDuration < 1 ||
+        params->utilization < 1 || params->burstSize < 1 || numCpus < 1) {
+        setEngineError(SPM_ERR_SETTINGS);
+        return 1;
+    }
+    if (params->numProcesses > MAX_PROCESSES) {
+        setEngineError(SPM_ERR_PROCESSES);
+        return 1;
+    }
+
+    // mean gap between arrivals that keeps the CPUs at the target utilization (mean duration / (cpus * utilization))
+    GenRandom random;
+    seedGenRandom(&random, (unsigned long long)params->seedHigh << 32 | params->seedLow);
+    double meanGap = params->meanDuration / (numCpus * (params->utilization / 100.0));
+    double startTime = 0;
+    for (unsigned int pid = 0; pid < params->numProcesses; pid++) {
+
+        // bursts arrive together, after a gap averaging the burst's share of time
+        if (params->arrivals == ARRIVAL_BURSTY) {
+            if (pid % params->burstSize == 0) startTime += meanGap * params->burstSize * 2 * nextGenUnit(&random);
+        }
+
+        // otherwise, exponential inter-arrival times (poisson arrivals)
+        else startTime += -log(1.0 - nextGenUnit(&random)) * meanGap;
+        if (startTime > MAX_TIME_AND_PID) {
+            setEngineError(SPM_ERR_SETTINGS);
+            return 1;
+        }
+
+        // add process
+        unsigned int duration = nextDuration(&random, params);
+        if (addProcessBack(procList, (Process){ .pid = pid, .startTime = (unsigned int)startTime, .duration = duration, .remainingTime = duration, .rrTime = 0 }) == NULL) {
+            setEngineError(SPM_ERR_MEMORY);
+            return 1;
+        }
+    }
+    setEngineError(SPM_OK);
+    return 0;
+}
+
+// returns null on failure (engine error set)
+ProcessManager* createGeneratedManager(const SimConfig* config, const GenParams* params) {
+
+    if (params == NULL) {
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+
+    // create empty procman (verifies the settings) and generate into its pool
+    ProcessManager* procMgr = createManagerFromArray(config, NULL, 0);
+    if (procMgr == NULL) return NULL;
+    if (generateProcesses(&procMgr->unstarted, procMgr->numCpus, params)) {
+        freeProcessManager(procMgr);
+        return NULL;
+    }
+    return procMgr;
+}
@@ -0,0 +1,57 @@
+// This header file represents seeded synthetic workloads generated inside the engine.
+// Processes are written straight into a process list in start time order, so a large stress run is reproduced from its parameters and seed alone.
+
+#ifndef PROCGEN_H
+#define PROCGEN_H
+
+#include "procmgr.h"
+
+// generated durations are capped here (pareto tails are unbounded)
+#define GEN_MAX_DURATION 1000000
+
+// arrival patterns
+enum ArrivalPatterns {
+    ARRIVAL_POISSON, // exponential inter-arrival times
+    ARRIVAL_BURSTY,  // bursts of processes arriving together, separated by proportionally longer gaps
+    NUM_ARRIVAL_PATTERNS
+};
+
+// duration distributions (each with the requested mean, up to rounding)
+enum DurationDistributions {
+    DURATION_EXPONENTIAL,
+    DURATION_UNIFORM, // [1, 2 * mean - 1]
+    DURATION_PARETO,  // alpha = 1.5 (heavy tailed; minimum mean / 3)
+    NUM_DURATION_DISTRIBUTIONS
+};
+
+// generator parameters (all 32-bit words, so JS writes them like SimConfig; do not reorder)
+typedef struct GenParams {
+
+    unsigned int numProcesses;
+    unsigned int arrivals;     // enum ArrivalPatterns
+    unsigned int durations;    // enum DurationDistributions
+    unsigned int meanDuration; // seconds (at least 1)
+    unsigned int utilization;  // target CPU utilization in percent; the arrival rate is set from it and the CPU count
+    unsigned int burstSize;    // processes per burst (bursty arrivals only)
+    unsigned int seedLow;      // 64-bit seed
+    unsigned int seedHigh;
+
+} GenParams;
+
+// xoshiro256** state
+typedef struct GenRandom {
+
+    unsigned long long state[4];
+
+} GenRandom;
+
+void seedGenRandom(GenRandom* random, unsigned long long seed);
+unsigned long long nextGenRandom(GenRandom* random);
+double nextGenUnit(GenRandom* random); // uniform in [0, 1)
+
+int generateProcesses(ProcessList* procList, unsigned int numCpus, const GenParams* params); // appends in start time order; returns 1 on failure (engine error set)
+ProcessManager* createGeneratedManager(const SimConfig* config, const GenParams* params);
+IntervalBuffer* getGeneratedIntervalData(const SimConfig* config, const GenParams* params); // free with freeIntervalData
+SimMetrics* getGeneratedMetrics(const SimConfig* config, const GenParams* params);
+
+#endif
@@ -0,0 +1,116 @@
+#include "procheap.h"
+#include <stdlib.h>
+
+// create process heap
+ProcessHeap createProcessHeap(char isMaxHeap) {
+
+    return (ProcessHeap){ .entries = NULL, .size = 0, .capacity = 0, .nextSeq = 0, .numGrows = 0, .isMaxHeap = isMaxHeap };
+}
+
+// returns 1 if entry a should be popped before entry b, 0 otherwise
+static int isHigherPriority(ProcessHeap* procHeap, ProcessHeapEntry* a, ProcessHeapEntry* b) {
+
+    if (a->key != b->key)
+        return procHeap->isMaxHeap ? a->key > b->key : a->key < b->key;
+    return a->seq < b->seq;
+}
+
+// place entry at index and update its node handle
+static void setEntry(ProcessHeap* procHeap, unsigned int index, ProcessHeapEntry entry) {
+
+    procHeap->entries[index] = entry;
+    entry.node->heapIndex = index;
+}
+
+// move entry at index up until its parent has higher priority
+static void siftUp(ProcessHeap* procHeap, unsigned int index) {
+
+    ProcessHeapEntry entry = procHeap->entries[index];
+    while (index > 0) {
+        unsigned int parent = (index - 1) / 2;
+        if (!isHigherPriority(procHeap, &entry, &procHeap->entries[parent])) break;
+        setEntry(procHeap, index, procHeap->entries[parent]);
+        index = parent;
+    }
+    setEntry(procHeap, index, entry);
+}
+
+// move entry at index down until both children have lower priority
+static void siftDown(ProcessHeap* procHeap, unsigned int index) {
+
+    ProcessHeapEntry entry = procHeap->entries[index];
+    while (2 * index + 1 < procHeap->size) {
+
+        // pick higher priority child
+        unsigned int child = 2 * index + 1;
+        if (child + 1 < procHeap->size && isHigherPriority(procHeap, &procHeap->entries[child + 1], &procHeap->entries[child]))
+            child++;
+
+        if (!isHigherPriority(procHeap, &procHeap->entries[child], &entry)) break;
+        setEntry(procHeap, index, procHeap->entries[child]);
+        index = child;
+    }
+    setEntry(procHeap, index, entry);
+}
+
+// returns 0 on success, 1 otherwise
+int pushProcessHeap(ProcessHeap* procHeap, ProcessNode* procNode, unsigned long long key) {
+
+    // grow entries (geometrically) if full
+    if (procHeap->size == procHeap->capacity) {
+        unsigned int capacity = procHeap->capacity ? procHeap->capacity * 2 : 16;
+        ProcessHeapEntry* entries = realloc(procHeap->entries, sizeof(ProcessHeapEntry) * capacity);
+        if (entries == NULL) return 1;
+        procHeap->entries = entries;
+        procHeap->capacity = capacity;
+        procHeap->numGrows++;
+    }
+
+    // add to bottom and restore heap order
+    procHeap->entries[procHeap->size] = (ProcessHeapEntry){ .key = key, .seq = procHeap->nextSeq++, .node = procNode };
+    siftUp(procHeap, procHeap->size++);
+    return 0;
+}
+
+ProcessNode* peekProcessHeap(ProcessHeap* procHeap) {
+
+    return procHeap->size > 0 ? procHeap->entries[0].node : NULL;
+}
+
+// returns the key of the next entry to pop (0 for empty heap)
+unsigned long long peekProcessHeapKey(ProcessHeap* procHeap) {
+
+    return procHeap->size > 0 ? procHeap->entries[0].key : 0;
+}
+
+ProcessNode* popProcessHeap(ProcessHeap* procHeap) {
+
+    // return null for empty heap
+    if (procHeap->size == 0) return NULL;
+
+    // remove top entry
+    ProcessNode* procNode = procHeap->entries[0].node;
+    removeProcessHeap(procHeap, procNode);
+    return procNode;
+}
+
+void removeProcessHeap(ProcessHeap* procHeap, ProcessNode* procNode) {
+
+    // move last entry into the removed slot
+    unsigned int index = procNode->heapIndex;
+    if (index != --procHeap->size) {
+        setEntry(procHeap, index, procHeap->entries[procHeap->size]);
+
+        // restore heap order (the moved entry may belong above or below its new slot)
+        if (index > 0 && isHigherPriority(procHeap, &procHeap->entries[index], &procHeap->entries[(index - 1) / 2]))
+            siftUp(procHeap, index);
+        else
+            siftDown(procHeap, index);
+    }
+}
+
+void freeProcessHeap(ProcessHeap procHeap) {
+
+    // free entries (nodes are owned by their process list)
+    free(procHeap.entries);
+}
@@ -0,0 +1,41 @@
+// This header file represents an indexed binary heap of process nodes.
+// This is useful for picking the shortest / longest process without scanning a whole process list.
+
+#ifndef PROCHEAP_H
+#define PROCHEAP_H
+
+#include "proclist.h"
+
+// heap entry (key is stored inline to avoid chasing node pointers while sifting)
+typedef struct ProcessHeapEntry {
+
+    unsigned long long key; // wide enough for absolute times
+    unsigned int seq;           // insertion order; breaks ties so equal keys come out first-in first-out
+    struct ProcessNode* node;
+
+} ProcessHeapEntry;
+
+// process heap (nodes are owned by a process list; the heap only indexes them)
+typedef struct ProcessHeap {
+
+    struct ProcessHeapEntry* entries;
+    unsigned int size;
+    unsigned int capacity;
+    unsigned int nextSeq;
+    unsigned int numGrows; // entry array allocations so far (engine statistics)
+    char isMaxHeap; // 0 pops minimum key first, 1 pops maximum key first
+
+} ProcessHeap;
+
+ProcessHeap createProcessHeap(char isMaxHeap);
+
+int pushProcessHeap(ProcessHeap* procHeap, ProcessNode* procNode, unsigned long long key);
+
+ProcessNode* peekProcessHeap(ProcessHeap* procHeap);
+unsigned long long peekProcessHeapKey(ProcessHeap* procHeap);
+ProcessNode* popProcessHeap(ProcessHeap* procHeap);
+void removeProcessHeap(ProcessHeap* procHeap, ProcessNode* procNode); // note: process node is not verified to be in process heap
+
+void freeProcessHeap(ProcessHeap procHeap);
+
+#endif
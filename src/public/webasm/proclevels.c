@@ -0,0 +1,118 @@
+#include "proclevels.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// the ready bitmap is one word
+_Static_assert(MLFQ_LEVELS <= 64, "too many feedback levels");
+
+// create empty level index
+ProcessLevels createProcessLevels() {
+
+    ProcessLevels procLevels;
+    memset(&procLevels, 0, sizeof(ProcessLevels));
+    return procLevels;
+}
+
+// returns 0 on success, 1 otherwise
+int pushProcessLevels(ProcessLevels* procLevels, ProcessNode* procNode) {
+
+    // grow ring (geometrically) if full, unwrapping it so the oldest entry is first again
+    unsigned int level = procNode->process.level;
+    LevelQueue* levelQueue = &procLevels->levels[level];
+    if (levelQueue->size == levelQueue->capacity) {
+        unsigned int capacity = levelQueue->capacity ? levelQueue->capacity * 2 : 16;
+        ProcessNode** nodes = malloc(sizeof(ProcessNode*) * capacity);
+        if (nodes == NULL) return 1;
+        unsigned int firstRun = levelQueue->capacity - levelQueue->head;
+        if (firstRun > levelQueue->size) firstRun = levelQueue->size;
+        if (levelQueue->size > 0) {
+            memcpy(nodes, levelQueue->nodes + levelQueue->head, sizeof(ProcessNode*) * firstRun);
+            memcpy(nodes + firstRun, levelQueue->nodes, sizeof(ProcessNode*) * (levelQueue->size - firstRun));
+        }
+        free(levelQueue->nodes);
+        levelQueue->nodes = nodes;
+        levelQueue->head = 0;
+        levelQueue->capacity = capacity;
+        procLevels->numGrows++;
+    }
+
+    // add to back and mark level ready
+    levelQueue->nodes[(levelQueue->head + levelQueue->size++) & (levelQueue->capacity - 1)] = procNode;
+    procLevels->readyMask |= 1ull << level;
+    procLevels->size++;
+    return 0;
+}
+
+ProcessNode* popProcessLevels(ProcessLevels* procLevels) {
+
+    // return null if nothing waits
+    if (procLevels->readyMask == 0) return NULL;
+
+    // take the oldest entry of the lowest set bit (the highest waiting level)
+    unsigned int level = __builtin_ctzll(procLevels->readyMask);
+    LevelQueue* levelQueue = &procLevels->levels[level];
+    ProcessNode* procNode = levelQueue->nodes[levelQueue->head];
+    levelQueue->head = (levelQueue->head + 1) & (levelQueue->capacity - 1);
+    if (--levelQueue->size == 0)
+        procLevels->readyMask &= ~(1ull << level);
+    procLevels->size--;
+    return procNode;
+}
+
+unsigned int peekProcessLevel(ProcessLevels* procLevels) {
+
+    return procLevels->readyMask != 0 ? (unsigned int)__builtin_ctzll(procLevels->readyMask) : MLFQ_LEVELS;
+}
+
+void clearProcessLevels(ProcessLevels* procLevels) {
+
+    for (unsigned int level = 0; level < MLFQ_LEVELS; level++) {
+        procLevels->levels[level].head = 0;
+        procLevels->levels[level].size = 0;
+    }
+    procLevels->readyMask = 0;
+    procLevels->size = 0;
+}
+
+void addRunningLevel(RunningLevels* runLevels, unsigned int level) {
+
+    runLevels->counts[level]++;
+    runLevels->mask |= 1ull << level;
+}
+
+void removeRunningLevel(RunningLevels* runLevels, unsigned int level) {
+
+    if (--runLevels->counts[level] == 0)
+        runLevels->mask &= ~(1ull << level);
+}
+
+unsigned int getLowestRunningLevel(RunningLevels* runLevels) {
+
+    return runLevels->mask != 0 ? 63 - (unsigned int)__builtin_clzll(runLevels->mask) : 0;
+}
+
+// quanta double per level (a zero quantum runs one second at a time, as round robin does)
+unsigned int getLevelQuantum(unsigned int rrQuantum, unsigned int level) {
+
+    unsigned long long quantum = (unsigned long long)(rrQuantum ? rrQuantum : 1) << level;
+    return quantum < UINT_MAX ? (unsigned int)quantum : UINT_MAX;
+}
+
+// the running set counts every process against one quantum (the longest level's), so a level's quantum is what is left of it from here
+unsigned int getLevelRrTime(unsigned int rrQuantum, unsigned int level) {
+
+    return getLevelQuantum(rrQuantum, MLFQ_LEVELS - 1) - getLevelQuantum(rrQuantum, level);
+}
+
+unsigned long long getBoostPeriod(unsigned int rrQuantum) {
+
+    return (unsigned long long)MLFQ_BOOST_QUANTA * (rrQuantum ? rrQuantum : 1);
+}
+
+void freeProcessLevels(ProcessLevels procLevels) {
+
+    // free rings (nodes are owned by their process list)
+    for (unsigned int level = 0; level < MLFQ_LEVELS; level++)
+        free(procLevels.levels[level].nodes);
+}
@@ -0,0 +1,60 @@
+// This header file represents the priority levels of a multilevel feedback queue as an index of waiting process nodes.
+// Each level is first-in first-out, and a bitmap of non-empty levels finds the highest waiting one with a single find-first-set (like the O(1) Linux scheduler's priority arrays), so selection costs the same however many processes wait.
+
+#ifndef PROCLEVELS_H
+#define PROCLEVELS_H
+
+#include "proclist.h"
+
+// level 0 is the highest priority; level l runs for rrQuantum * 2^l seconds before the process is demoted
+#define MLFQ_LEVELS 8
+
+// every process returns to level 0 once per this many base quanta (so demoted processes cannot starve)
+#define MLFQ_BOOST_QUANTA 64
+
+// waiting processes of one level (a ring of node pointers, oldest at 'head')
+typedef struct LevelQueue {
+
+    struct ProcessNode** nodes;
+    unsigned int head;
+    unsigned int size;
+    unsigned int capacity; // power of two (0 until the first push)
+
+} LevelQueue;
+
+// level index (nodes are owned by a process list; the levels only index them by their process's 'level')
+typedef struct ProcessLevels {
+
+    struct LevelQueue levels[MLFQ_LEVELS];
+    unsigned long long readyMask; // bit per level, set while it has waiting processes
+    unsigned int size;
+    unsigned int numGrows; // ring allocations so far (engine statistics)
+
+} ProcessLevels;
+
+// levels of the running processes (the lowest priority one running is the highest set bit, so preemption checks are one bit scan too)
+typedef struct RunningLevels {
+
+    unsigned int counts[MLFQ_LEVELS];
+    unsigned long long mask; // bit per level, set while a process at it runs
+
+} RunningLevels;
+
+ProcessLevels createProcessLevels();
+
+int pushProcessLevels(ProcessLevels* procLevels, ProcessNode* procNode); // appends to its process's level; returns 1 on failure
+ProcessNode* popProcessLevels(ProcessLevels* procLevels); // oldest process of the highest waiting level (null if none)
+unsigned int peekProcessLevel(ProcessLevels* procLevels); // highest waiting level (MLFQ_LEVELS if none)
+void clearProcessLevels(ProcessLevels* procLevels); // drops every entry (rings are kept)
+
+void addRunningLevel(RunningLevels* runLevels, unsigned int level);
+void removeRunningLevel(RunningLevels* runLevels, unsigned int level);
+unsigned int getLowestRunningLevel(RunningLevels* runLevels); // lowest priority level running (0 if none)
+
+unsigned int getLevelQuantum(unsigned int rrQuantum, unsigned int level); // at least 1, capped at 2^32 - 1
+unsigned int getLevelRrTime(unsigned int rrQuantum, unsigned int level); // rrTime a process starts a level's quantum with (see Process)
+unsigned long long getBoostPeriod(unsigned int rrQuantum);
+
+void freeProcessLevels(ProcessLevels procLevels);
+
+#endif
@@ -1,62 +1,81 @@
-
 #include "proclist.h"
+#include "procpool.h"
+#include "spmlimits.h"
+#include "spmparse.h"
 #include <stdlib.h>
+#include <string.h>
+#ifdef __EMSCRIPTEN__
 #include <emscripten/emscripten.h>
+#endif
 
 // create process list
-ProcessList createProcessList() {
+ProcessList createProcessList(ProcessPool* procPool) {
 
-    return (ProcessList){ .head = NULL, .tail = NULL, .size = 0 };
+    return (ProcessList){ .head = NULL, .tail = NULL, .size = 0, .pool = procPool };
 }
 
-// parse list
-ProcessList parseListFromString(char* str) {
+// parse list ('pid,start,duration,' per process; an empty field is 0)
+ProcessList parseListFromString(char* str, ProcessPool* procPool) {
 
     // init new empty process list
-    ProcessList procList = createProcessList();
-
-    // store stateful params and iterator
-    unsigned int params[] = { 0, 0, 0 };
-    unsigned int tokenType = 0; // 0, 1, 2
-
-    // loop through chars until null char is reached
-    for (int i = 0; str[i] != '\0'; i++) {
-
-        // valid; add digit to current token type number
-        if (str[i] >= '0' && str[i] <= '9')
-            params[tokenType] = params[tokenType] * 10 + (str[i] - '0');
-
-        // valid; terminate field
-        else if (str[i] == ',') {
-            
-            // end of process; add process, reset token type, reset values
-            if (tokenType == 2) {
-                addProcessBack(&procList, (Process){ .pid = params[0], .startTime = params[1], .remainingTime = params[2], .rrTime = 0 });
-                tokenType = 0;
-                for (int i = 0; i < 3; i++)
-                    params[i] = 0;
-                continue; // we dont want to increment token type
+    ProcessList procList = createProcessList(procPool);
+
+    // parse numbers a word at a time (see spmparse.h); every field is terminated by a comma
+    size_t len = strlen(str);
+    size_t i = 0;
+    while (i < len) {
+        unsigned long long params[3];
+        for (int field = 0; field < 3; field++) {
+            i += parseDecimal(str + i, len - i, &params[field]);
+
+            // over limit, invalid character or unfinished data; free list and return empty list
+            if (params[field] > MAX_TIME_AND_PID || i == len || str[i] != ',') {
+                freeProcessList(procList);
+                return createProcessList(procPool);
             }
+            i++;
+        }
 
-            // increment token type
-            tokenType++;
+        // add process (invalid if too many processes or out of memory)
+        if (procList.size >= MAX_PROCESSES || addProcessBack(&procList, (Process){ .pid = params[0], .startTime = params[1], .duration = params[2], .remainingTime = params[2], .rrTime = 0 }) == NULL) {
+            freeProcessList(procList);
+            return createProcessList(procPool);
+        }
+    }
 
-        // invalid character; free list and return null
-        } else return createProcessList();
+    // return list
+    return procList;
+}
+
+// appends processes from packed (pid, start, duration) triples; returns 1 on failure (the list keeps the processes added before it)
+int addProcessesFromArray(ProcessList* procList, const unsigned int* processes, unsigned int numProcesses) {
+
+    for (unsigned int i = 0; i < numProcesses; i++) {
+        const unsigned int* params = processes + 3 * i;
+        if (addProcessBack(procList, (Process){ .pid = params[0], .startTime = params[1], .duration = params[2], .remainingTime = params[2], .rrTime = 0 }) == NULL)
+            return 1;
     }
+    return 0;
+}
 
-    // unfinished data; return empty list
-    if (tokenType != 0) return createProcessList();
+// allocate node from the list's pool (or malloc if it has none)
+ProcessNode* allocNode(ProcessList* procList) {
 
-    // otherwise, return list
-    return procList;
+    return procList->pool != NULL ? allocProcessNode(procList->pool) : malloc(sizeof(ProcessNode));
+}
+
+// release node to the list's pool (or free if it has none)
+void releaseNode(ProcessList* procList, ProcessNode* procNode) {
+
+    if (procList->pool != NULL) releaseProcessNode(procList->pool, procNode);
+    else free(procNode);
 }
 
-// returns 0 on success, 1 otherwise
+// returns null on failure
 ProcessNode* addProcessFront(ProcessList* procList, Process process) {
 
     // create new process node
-    ProcessNode* procNode = malloc(sizeof(ProcessNode));
+    ProcessNode* procNode = allocNode(procList);
     if (procNode == NULL) return NULL;
     procNode->process = process;
 
@@ -83,14 +102,61 @@ ProcessNode* addProcessFront(ProcessList* procList, Process process) {
     return procNode;
 }
 
-// returns 0 on success, 1 otherwise
+// returns null on failure
 ProcessNode* addProcessBack(ProcessList* procList, Process process) {
 
     // create new process node
-    ProcessNode* procNode = malloc(sizeof(ProcessNode));
+    ProcessNode* procNode = allocNode(procList);
+    if (procNode == NULL) return NULL;
+    procNode->process = process;
+
+    // add after tail
+    linkProcessBack(procList, procNode);
+    return procNode;
+}
+
+// returns null on failure; searches from the tail, since new processes usually start last
+ProcessNode* insertProcessByStartTime(ProcessList* procList, Process process) {
+
+    // find the last node starting at or before the process
+    ProcessNode* prevNode = procList->tail;
+    while (prevNode != NULL && prevNode->process.startTime > process.startTime)
+        prevNode = prevNode->prev;
+    if (prevNode == procList->tail) return addProcessBack(procList, process);
+    if (prevNode == NULL) return addProcessFront(procList, process);
+
+    // create new process node
+    ProcessNode* procNode = allocNode(procList);
     if (procNode == NULL) return NULL;
     procNode->process = process;
 
+    // link between prevNode and its next node
+    procNode->prev = prevNode;
+    procNode->next = prevNode->next;
+    prevNode->next->prev = procNode;
+    prevNode->next = procNode;
+    procList->size++;
+    return procNode;
+}
+
+void unlinkProcess(ProcessList* procList, ProcessNode* procNode) {
+
+    // repair previous node (or head)
+    if (procNode->prev != NULL) procNode->prev->next = procNode->next;
+    else procList->head = procNode->next;
+
+    // repair next node (or tail)
+    if (procNode->next != NULL) procNode->next->prev = procNode->prev;
+    else procList->tail = procNode->prev;
+
+    // detach and decrement size
+    procNode->prev = NULL;
+    procNode->next = NULL;
+    procList->size--;
+}
+
+void linkProcessBack(ProcessList* procList, ProcessNode* procNode) {
+
     // set to head and tail if no items
     if (procList->head == NULL) {
 
@@ -111,6 +177,13 @@ ProcessNode* addProcessBack(ProcessList* procList, Process process) {
 
     // increment size
     procList->size++;
+}
+
+// returns the moved process node (same node, now in destination list)
+ProcessNode* moveProcessBack(ProcessList* procListSrc, ProcessList* procListDest, ProcessNode* procNode) {
+
+    unlinkProcess(procListSrc, procNode);
+    linkProcessBack(procListDest, procNode);
     return procNode;
 }
 
@@ -133,19 +206,11 @@ ProcessNode* getShortestRemainingTime(ProcessList* procList) {
 }
 
 // this assumes the processes are sorted by start time
-void transferProcessesUpToStartTime(ProcessList* procListSrc, ProcessList* procListDest, unsigned int startTime) {
+void transferProcessesUpToStartTime(ProcessList* procListSrc, ProcessList* procListDest, unsigned long long startTime) {
     
-    // iterate through nodes (with sorted optimization)
-    ProcessNode* curNode = procListSrc->head;
-    while (curNode != NULL && curNode->process.startTime <= startTime) {
-
-        // return process node if start time found
-        addProcessBack(procListDest, curNode->process);
-        removeProcessFront(procListSrc);
-
-        // iterate
-        curNode = curNode->next;
-    }
+    // relink nodes from the head (with sorted optimization)
+    while (procListSrc->head != NULL && procListSrc->head->process.startTime <= startTime)
+        moveProcessBack(procListSrc, procListDest, procListSrc->head);
 }
 
 int removeProcessFront(ProcessList* procList) {
@@ -153,22 +218,9 @@ int removeProcessFront(ProcessList* procList) {
     // no elements
     if (procList->head == NULL)
         return 1;
-    
-    // one element
-    else if (procList->head == procList->tail) {
-        free(procList->head);
-        procList->head = NULL;
-        procList->tail = NULL;
 
-    // more than one element
-    } else {
-        procList->head = procList->head->next;
-        free(procList->head->prev);
-        procList->head->prev = NULL;
-    }
-
-    // decrement size
-    procList->size--;
+    // unlink and release head
+    removeProcess(procList, procList->head);
 
     // return success
     return 0;
@@ -179,22 +231,9 @@ int removeProcessBack(ProcessList* procList) {
     // no elements
     if (procList->head == NULL)
         return 1;
-    
-    // one element
-    else if (procList->head == procList->tail) {
-        free(procList->head);
-        procList->head = NULL;
-        procList->tail = NULL;
 
-    // more than one element
-    } else {
-        procList->tail = procList->tail->prev;
-        free(procList->tail->next);
-        procList->tail->next = NULL;
-    }
-
-    // decrement size
-    procList->size--;
+    // unlink and release tail
+    removeProcess(procList, procList->tail);
 
     // return success
     return 0;
@@ -202,93 +241,81 @@ int removeProcessBack(ProcessList* procList) {
 
 void removeProcess(ProcessList* procList, ProcessNode* procNode) {
     
-    // process node is head
-    if (procNode == procList->head)
-        removeProcessFront(procList);
-
-    // process node is tail
-    else if (procNode == procList->tail)
-        removeProcessBack(procList);
-
-    // process node is in middle
-    else {
-        procNode->prev->next = procNode->next;
-        procNode->next->prev = procNode->prev;
-        free(procNode);
-        procList->size--;
-    }
+    unlinkProcess(procList, procNode);
+    releaseNode(procList, procNode);
 }
 
-// insertion sort - easy with linked lists
-void sortProcessList(ProcessList* procList) {
+// stable LSD radix sort on start time (one byte per pass), so the list becomes an arrival index read from the head
+// returns 0 on success, 1 if the scratch index could not be allocated (list unchanged)
+int sortProcessList(ProcessList* procList) {
 
     // return if no processes or one process (already sorted)
     if (procList->head == procList->tail)
-        return;
-
-    // start at one from head
-    ProcessNode* iterNode = procList->head->next;
-
-    // loop for all nodes (must be >= 2 nodes)
-    while (iterNode != NULL) {
-
-        // make curNode and advance iterNode (well be moving curNode, so curNode->next will not be the expected next node)
-        ProcessNode* curNode = iterNode;
-        iterNode = iterNode->next;
-
-        // start comparison at previous node
-        ProcessNode* compareNode = curNode->prev;
-
-        // loop from compare node to before head or process <=
-        while (compareNode != NULL && curNode->process.startTime < compareNode->process.startTime)
-            compareNode = compareNode->prev;
-
-        // 1. do NOT change list if curNode is already sorted in relation to previous nodes
-
-        // if compareNode hasnt changed, move on
-        if (compareNode == curNode->prev) continue;
-        
-        // 2. otherwise, we at least know the current nodes current spot needs to be repaired first
-        // tail removal: tail->prev->next is tail->next (null), and tail is tail->prev
-        // other removals: curNode->prev->next is curNode->next, and curNode->next->prev is curNode->prev
-        
-        // we know curNode can be head->next to tail, so we can safely change curNode->prev->next to curNode->next (even if null)
-        curNode->prev->next = curNode->next;
-
-        // if tail, update tail
-        if (curNode == procList->tail) procList->tail = procList->tail->prev;
-        // otherwise, we update curNode->next->prev to curNode->prev
-        else curNode->next->prev = curNode->prev;
+        return 0;
 
-        // 3. the list should now be independent from curNode, but curNode must be attached to its intended location
-        // since were going left and nodes cant swap with themselves, curNode will never swap with tail (though it may be the tail)
-        // if compareNode is null, curNode MUST be moved to the head
-        if (compareNode == NULL) {
+    // return if already sorted (e.g. generated workloads)
+    ProcessNode* curNode = procList->head;
+    while (curNode->next != NULL && curNode->process.startTime <= curNode->next->process.startTime)
+        curNode = curNode->next;
+    if (curNode->next == NULL)
+        return 0;
 
-            // set curNode relations
-            curNode->next = procList->head; // place before head
-            curNode->prev = NULL;            // make prev node null
+    // allocate index (node pointers) and scratch space for one pass
+    ProcessNode** indexMem = malloc(sizeof(ProcessNode*) * 2 * procList->size);
+    if (indexMem == NULL)
+        return 1;
+    ProcessNode** index = indexMem;
+    ProcessNode** scratch = indexMem + procList->size;
+
+    // fill index in list order and count every byte of every start time at once
+    unsigned int counts[4][256] = { { 0 } };
+    unsigned int numNodes = 0;
+    for (curNode = procList->head; curNode != NULL; curNode = curNode->next) {
+        index[numNodes++] = curNode;
+        for (int pass = 0; pass < 4; pass++)
+            counts[pass][(curNode->process.startTime >> (8 * pass)) & 0xFF]++;
+    }
 
-            // set head relations
-            procList->head->prev = curNode; // make head->prev direct to new head
+    // scatter by each byte from least significant (stable, so equal start times keep list order)
+    for (int pass = 0; pass < 4; pass++) {
 
-            // set as head
-            procList->head = curNode;       // finally, set as new head
+        // skip bytes every start time shares (e.g. the high bytes of small times)
+        unsigned int* count = counts[pass];
+        if (count[(index[0]->process.startTime >> (8 * pass)) & 0xFF] == numNodes)
+            continue;
 
-        // otherwise, repair surrounding nodes and insert
-        } else {
+        // turn counts into offsets
+        unsigned int offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            unsigned int digitCount = count[digit];
+            count[digit] = offset;
+            offset += digitCount;
+        }
 
-            // set curNode relations
-            curNode->prev = compareNode;
-            curNode->next = compareNode->next;
+        // scatter and swap buffers
+        for (unsigned int i = 0; i < numNodes; i++)
+            scratch[count[(index[i]->process.startTime >> (8 * pass)) & 0xFF]++] = index[i];
+        ProcessNode** tmpIndex = index;
+        index = scratch;
+        scratch = tmpIndex;
+    }
 
-            // set surrounding relations
-            compareNode->next->prev = curNode;
-            compareNode->next = curNode;
-        }
+    // relink list in index order
+    procList->head = index[0];
+    procList->tail = index[numNodes - 1];
+    index[0]->prev = NULL;
+    for (unsigned int i = 1; i < numNodes; i++) {
+        index[i - 1]->next = index[i];
+        index[i]->prev = index[i - 1];
     }
+    procList->tail->next = NULL;
+
+    // free index
+    free(indexMem);
+    return 0;
 }
 
+// pooled nodes are returned to the pool (which frees them all at once)
 void freeProcessList(ProcessList procList) {
 
     // free nodes
@@ -296,6 +323,6 @@ void freeProcessList(ProcessList procList) {
     while (procNode != NULL) {
         ProcessNode* tmpNode = procNode;
         procNode = procNode->next;
-        free(tmpNode);
+        releaseNode(&procList, tmpNode);
     }
 }
@@ -2,16 +2,24 @@
 // This header file represents a dynamic means of adding and removing elements via a linked list.
 // This is useful for stack / queue implementations.
 
+#ifndef PROCLIST_H
+#define PROCLIST_H
+
+// node allocator (see procpool.h)
+struct ProcessPool;
+
 // process
 typedef struct Process {
 
     // static properties
     unsigned int pid;
     unsigned int startTime;
+    unsigned int duration;
 
     // dynamic properties
     unsigned int remainingTime; // number of seconds remaining
-    unsigned int rrTime;  // rr run time
+    unsigned int rrTime;  // rr run time (MLFQ: offset so it reaches the longest level quantum once the process's own level quantum is used)
+    unsigned int level;   // feedback queue level (MLFQ only; 0 is the highest priority)
 
 } Process;
 
@@ -23,6 +31,15 @@ typedef struct ProcessNode {
     struct ProcessNode* prev;
     struct ProcessNode* next;
 
+    // process heap handle (index of entry, only valid while indexed by a heap)
+    unsigned int heapIndex;
+
+    // CPU whose run queue holds or runs the process (only with per-CPU run queues or interval output)
+    unsigned int cpu;
+
+    // open execution interval while running (only with interval output)
+    unsigned int interval;
+
 } ProcessNode;
 
 // process list
@@ -32,22 +49,33 @@ typedef struct ProcessList {
     struct ProcessNode* tail;
     unsigned int size;
 
+    struct ProcessPool* pool; // node allocator (null uses malloc / free)
+
 } ProcessList;
 
-ProcessList createProcessList();
-ProcessList parseListFromString(char* str);
+ProcessList createProcessList(struct ProcessPool* procPool);
+ProcessList parseListFromString(char* str, struct ProcessPool* procPool);
+int addProcessesFromArray(ProcessList* procList, const unsigned int* processes, unsigned int numProcesses); // packed (pid, start, duration) triples
 
 ProcessNode* addProcessFront(ProcessList* procList, Process process);
 ProcessNode* addProcessBack(ProcessList* procList, Process process);
+ProcessNode* insertProcessByStartTime(ProcessList* procList, Process process); // keeps a start time sorted list sorted (after equal start times)
+
+// intrusive moves (node is relinked, not reallocated; lists must share the same pool)
+void unlinkProcess(ProcessList* procList, ProcessNode* procNode); // note: process node is not verified to be in process list
+void linkProcessBack(ProcessList* procList, ProcessNode* procNode);
+ProcessNode* moveProcessBack(ProcessList* procListSrc, ProcessList* procListDest, ProcessNode* procNode);
 
 ProcessNode* getShortestRemainingTime(ProcessList* procList);
 
-void transferProcessesUpToStartTime(ProcessList* procListSrc, ProcessList* procListDest, unsigned int startTime);
+void transferProcessesUpToStartTime(ProcessList* procListSrc, ProcessList* procListDest, unsigned long long startTime);
 
 int removeProcessFront(ProcessList* procList);
 int removeProcessBack(ProcessList* procList);
 void removeProcess(ProcessList* procList, ProcessNode* procNode); // note: process node is not verified to be in process list
 
-void sortProcessList(ProcessList* procList);
+int sortProcessList(ProcessList* procList);
+
+void freeProcessList(ProcessList procList);
 
-void freeProcessList(ProcessList procList);
\ No newline at end of file
+#endif
@@ -1,28 +1,96 @@
 
 #include <stdio.h>
 #include "procmgr.h"
+#include "procgen.h"
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+
+#ifdef SPM_PROFILE
+#ifdef __EMSCRIPTEN__
+#include <emscripten/emscripten.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+// statistics of the last process manager freed on this thread (see spmGetStats)
+static _Thread_local EngineStats lastEngineStats;
+
+// error of the last engine call on this thread (see spmGetError)
+static _Thread_local enum SpmErrors lastError;
+
+#ifdef SPM_PROFILE
+// monotonic clock for phase timers (seconds)
+double getEngineSeconds() {
+
+#ifdef __EMSCRIPTEN__
+    return emscripten_get_now() / 1000;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+#endif
 
 // process manager
-ProcessManager* createProcessManager(unsigned int numCpus, enum Algorithms alg, unsigned int rrQuantum, ProcessList processes) {
+ProcessManager* createProcessManager(unsigned int numCpus, enum Algorithms alg, unsigned int rrQuantum) {
 
     // init new process manager
     ProcessManager* procMgr = malloc(sizeof(ProcessManager));
     if (procMgr == NULL) {
-        fputs("Failed to allocate process manager", stderr);
+        LOG_ERROR("Failed to allocate process manager\n");
+        return NULL;
+    }
+
+    // allocate running set (one slot per CPU)
+    procMgr->active = createActiveSet(numCpus);
+    if (procMgr->active.nodes == NULL) {
+        LOG_ERROR("Failed to allocate process manager\n");
+        free(procMgr);
         return NULL;
     }
 
-    // allocate process lists (empty)
-    procMgr->active = createProcessList();
-    procMgr->queue = createProcessList();
-    procMgr->unstarted = processes;
+    // allocate process lists (empty; all nodes come from the manager's pool)
+    procMgr->pool = createProcessPool();
+    procMgr->queue = createProcessList(&procMgr->pool);
+    procMgr->unstarted = createProcessList(&procMgr->pool);
+    procMgr->readArrivals = NULL;
+    procMgr->arrivalSource = NULL;
+
+    // allocate process heaps (empty)
+    procMgr->queueHeap = createProcessHeap(alg == LJF);
+    procMgr->activeHeap = createProcessHeap(1);
+
+    // allocate feedback levels (empty; rings grow on first use)
+    procMgr->queueLevels = createProcessLevels();
+    procMgr->activeLevels = (RunningLevels){ 0 };
+
+    // global queue until per-CPU run queues are requested
+    procMgr->runQueues = NULL;
 
     // set static values
     procMgr->numCpus = numCpus;
     procMgr->alg = alg;
     procMgr->rrQuantum = rrQuantum;
+    procMgr->errFlag = SPM_OK;
+
+    // reset clock and counters (statistics only when requested)
+    procMgr->time = 0;
+    procMgr->prevTime = 0;
+    procMgr->nextTime = 0;
+    procMgr->numDecisions = 0;
+    procMgr->stats = NULL;
+    procMgr->engineStats = (EngineStats){ 0 };
+
+    // no frame output until requested
+    procMgr->frameStr = NULL;
+    procMgr->frameStrLen = 0;
+    procMgr->frameStrCapacity = 0;
+    procMgr->frameBuf = NULL;
+    procMgr->intervals = NULL;
+    procMgr->checkpoints = NULL;
 
     // return process manager
     return procMgr;
@@ -31,18 +99,19 @@ ProcessManager* createProcessManager(unsigned int numCpus, enum Algorithms alg,
 // parse manager data
 ProcessManager* parseManagerFromString(char* str) {
 
-    // define array of params and token type to index
-    unsigned int params[] = { 0, 0, 0 };
+    // define array of params (wide enough to detect values over the 32-bit limit) and token type to index
+    unsigned long long params[] = { 0, 0, 0 };
     unsigned int tokenType = 0;
-    int i;
+    size_t i;
     for (i = 0; str[i] != '\0'; i++) {
 
-        // valid; add digit to current token type number
-        if (str[i] >= '0' && str[i] <= '9')
+        // valid; add digit to current token type number (invalid if over limit)
+        if (str[i] >= '0' && str[i] <= '9') {
             params[tokenType] = params[tokenType] * 10 + (str[i] - '0');
+            if (params[tokenType] > MAX_TIME_AND_PID) return NULL;
 
         // valid; terminate field
-        else if (str[i] == ',') {
+        } else if (str[i] == ',') {
 
             // end of metadata; set process manager fields
             if (tokenType == 2) break;
@@ -54,293 +123,951 @@ ProcessManager* parseManagerFromString(char* str) {
         } else return NULL;
     }
 
-    // verify
-    if (params[0] > MAX_NUM_CPUS || params[1] >= NUM_ALGS || params[2] > MAX_TIME_AND_PID) return NULL;
+    // verify (at least one CPU, otherwise queued processes could never finish)
+    if (str[i] == '\0' || params[0] < 1 || params[0] > MAX_NUM_CPUS || params[1] >= NUM_ALGS) return NULL;
+
+    // create procman and parse processes into its pool
+    ProcessManager* procMgr = createProcessManager(params[0], params[1], params[2]);
+    if (procMgr == NULL) return NULL;
+    procMgr->unstarted = parseListFromString(str + (sizeof(char) * (i + 1)), &procMgr->pool);
 
     // return procman
-    return createProcessManager(params[0], params[1], params[2], parseListFromString(str + (sizeof(char) * (i + 1))));
+    return procMgr;
 }
 
-void addFrame(ProcessManager* procMgr, char* frameStr) {
+// creates a manager from settings and packed (pid, start, duration) triples (no parsing); returns null on failure (see spmGetError)
+ProcessManager* createManagerFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses) {
 
-    // ALLOC
+    // verify (as parseManagerFromString does; every word is already in range)
+    if (config == NULL || (processes == NULL && numProcesses > 0)) {
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+    if (config->numCpus < 1 || config->numCpus > MAX_NUM_CPUS || config->alg >= NUM_ALGS) {
+        setEngineError(SPM_ERR_SETTINGS);
+        return NULL;
+    }
+    if (numProcesses > MAX_PROCESSES) {
+        setEngineError(SPM_ERR_PROCESSES);
+        return NULL;
+    }
+
+    // create procman and add processes into its pool
+    ProcessManager* procMgr = createProcessManager(config->numCpus, config->alg, config->rrQuantum);
+    if (procMgr == NULL) {
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    if (addProcessesFromArray(&procMgr->unstarted, processes, numProcesses)) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    setEngineError(SPM_OK);
+    return procMgr;
+}
 
-    // create temporary strings
-    char* tmpStr = malloc(sizeof(char) * (MAX_FRAME_STR_LEN + 1));
-    char* tmpProcessStr = malloc(sizeof(char) * 9); // max '255,255;'
+void setEngineError(enum SpmErrors error) {
 
-    // APPEND
+    lastError = error;
+}
 
-    // write queue size
-    snprintf(tmpProcessStr, 4, "%d;", procMgr->queue.size);
-    strncpy(tmpStr, tmpProcessStr, 4);
+// returns the error of the last engine call on the calling thread (SPM_OK if it succeeded)
+int spmGetError() {
 
-    // write processes
-    ProcessNode* curNode = procMgr->active.head;
-    while (curNode != NULL) {
+    return lastError;
+}
 
-        // write pid and remaining time
-        snprintf(tmpProcessStr, 8, "%d,%d;", curNode->process.pid, curNode->process.remainingTime);
-        strncat(tmpStr, tmpProcessStr, 8);
+// switches from the global queue to per-CPU run queues with work stealing (call before running); returns 1 on failure
+int usePerCpuQueues(ProcessManager* procMgr) {
 
-        // iterate
-        curNode = curNode->next;
-    }
+    procMgr->runQueues = createRunQueues(procMgr->numCpus, procMgr->alg == LJF, procMgr->alg == MLFQ, &procMgr->pool);
+    return procMgr->runQueues == NULL;
+}
 
-    // write newline
-    strcat(tmpStr, "\n");
-    puts(tmpStr);
+// streams arrivals from a source instead of adding every process up front (call before running, with no processes added); returns 1 on failure
+// the source is read ahead only to the first process starting after the current event, so unstarted processes stay few
+int useArrivalSource(ProcessManager* procMgr, ReadArrivals readArrivals, void* arrivalSource) {
 
-    // check if frameStr will overflow, just in case
-    if (strnlen(frameStr, MAX_FULL_FRAME_STR_LEN) + strnlen(tmpStr, MAX_FRAME_STR_LEN) > MAX_FULL_FRAME_STR_LEN) {
-        procMgr->errFlag = 1;
-        strcpy(frameStr, "EToo many frames");
-        return;
+    procMgr->readArrivals = readArrivals;
+    procMgr->arrivalSource = arrivalSource;
+    int status = readArrivals(arrivalSource, &procMgr->unstarted, 0);
+    if (status != 0) procMgr->readArrivals = NULL;
+    return status < 0;
+}
 
-    // otherwise, append temp str to frames str
-    } else
-        strncat(frameStr, tmpStr, MAX_FRAME_STR_LEN);
+// reads streamed arrivals up to 'time' (plus the first one after it, which is the next arrival event)
+void refillArrivals(ProcessManager* procMgr, unsigned long long time) {
 
-    // free temp strings
-    free(tmpStr);
-    free(tmpProcessStr);
+    if (procMgr->unstarted.tail != NULL && procMgr->unstarted.tail->process.startTime > time) return;
+    int status = procMgr->readArrivals(procMgr->arrivalSource, &procMgr->unstarted, time);
+    if (status < 0) procMgr->errFlag = SPM_ERR_INPUT;
+    if (status != 0) procMgr->readArrivals = NULL;
 }
 
-void doFIFO(ProcessManager* procMgr, char* frameStr) {
+// returns the number of waiting processes (over all run queues if per-CPU)
+unsigned int getQueueSize(ProcessManager* procMgr) {
 
-    // begin loop
-    for (int i = 0; i <= MAX_TIME_AND_PID && (procMgr->active.head != NULL || procMgr->queue.head != NULL || procMgr->unstarted.head != NULL); i++) {
+    return procMgr->queue.size + (procMgr->runQueues != NULL ? procMgr->runQueues->numQueued : 0);
+}
 
-        // transfer processes up to 'i' seconds from unstarted to queue
-        transferProcessesUpToStartTime(&procMgr->unstarted, &procMgr->queue, i);
+// appends a text frame ('queue_size;pid,remaining;...\n') to the frame string
+void addFrame(ProcessManager* procMgr, unsigned int elapsed) {
 
-        // add run time to all running processes; terminate finished processes
-        ProcessNode* curNode = procMgr->active.head;
-        while (curNode != NULL) {
-            if (--curNode->process.remainingTime <= 0)
-                removeProcess(&procMgr->active, curNode);
-            curNode = curNode->next;
+    // grow frame string (geometrically) if the longest possible frame does not fit
+    unsigned long long frameStrLen = procMgr->frameStrLen + MAX_FRAME_STR_LEN(procMgr->numCpus) + 1;
+    if (frameStrLen > procMgr->frameStrCapacity) {
+
+        // fail once over the output limit
+        unsigned long long capacity = procMgr->frameStrCapacity * 2;
+        if (capacity < frameStrLen) capacity = frameStrLen;
+        if (capacity > MAX_FRAME_DATA_BYTES) {
+            procMgr->errFlag = SPM_ERR_LIMIT;
+            strcpy(procMgr->frameStr, "EToo many frames");
+            return;
         }
 
-        // add queued processes to active in fifo order (for as many free CPUs)
-        for (int j = 0; j < procMgr->numCpus - procMgr->active.size && procMgr->queue.head != NULL; j++) {
-            addProcessBack(&procMgr->active, procMgr->queue.head->process);
-            removeProcessFront(&procMgr->queue);
+        // reallocate
+        char* frameStr = realloc(procMgr->frameStr, capacity);
+        if (frameStr == NULL) {
+            procMgr->errFlag = SPM_ERR_MEMORY;
+            strcpy(procMgr->frameStr, "EToo many frames");
+            return;
         }
+        procMgr->frameStr = frameStr;
+        procMgr->frameStrCapacity = capacity;
+        procMgr->engineStats.allocations++;
+    }
 
-        // add frame to frame string
-        addFrame(procMgr, frameStr);
+    // write directly after the current end of the frame string
+    char* frameStart = procMgr->frameStr + procMgr->frameStrLen;
+    char* curChar = frameStart;
 
-        // if error flag is set, fail and return
-        if (procMgr->errFlag)
-            return;
+    // write queue size
+    curChar += sprintf(curChar, "%u;", getQueueSize(procMgr));
+
+    // write processes (remaining time is offset by the seconds elapsed since the last event)
+    for (unsigned int i = 0; i < procMgr->active.size; i++)
+        curChar += sprintf(curChar, "%u,%u;", procMgr->active.pid[i], procMgr->active.remainingTime[i] - elapsed);
+
+    // write newline
+    *curChar++ = '\n';
+    *curChar = '\0';
+    LOG_TRACE("%s", frameStart);
+
+    // track end of frame string (avoids rescanning it for every frame)
+    procMgr->frameStrLen = curChar - procMgr->frameStr;
+}
+
+// writes a binary frame (queue size, then pid / remaining time per CPU) for the seconds elapsed since the last event
+void writeFrameData(ProcessManager* procMgr, unsigned int* frame, unsigned int elapsed) {
+
+    // write queue size
+    *frame++ = getQueueSize(procMgr);
+
+    // write processes (remaining time is offset by the seconds elapsed since the last event)
+    unsigned int numProcesses;
+    for (numProcesses = 0; numProcesses < procMgr->active.size; numProcesses++) {
+        *frame++ = procMgr->active.pid[numProcesses];
+        *frame++ = procMgr->active.remainingTime[numProcesses] - elapsed;
+    }
+
+    // mark remaining CPUs as idle
+    for (; numProcesses < procMgr->numCpus; numProcesses++) {
+        *frame++ = IDLE_CPU_PID;
+        *frame++ = 0;
     }
 }
 
-void doLIFO(ProcessManager* procMgr, char* frameStr) {
+// appends a binary frame to the frame buffer
+void addFrameData(ProcessManager* procMgr, unsigned int elapsed) {
 
-    // begin loop
-    for (int i = 0; i <= MAX_TIME_AND_PID && (procMgr->active.head != NULL || procMgr->queue.head != NULL || procMgr->unstarted.head != NULL); i++) {
+    // reserve frame (fail once over the output limit)
+    unsigned int capacity = procMgr->frameBuf->capacity;
+    if ((unsigned long long)(procMgr->frameBuf->size + procMgr->frameBuf->stride) * sizeof(unsigned int) > MAX_FRAME_DATA_BYTES) {
+        procMgr->errFlag = SPM_ERR_LIMIT;
+        return;
+    }
+    unsigned int* frame = reserveFrame(procMgr->frameBuf);
+    if (frame == NULL) {
+        procMgr->errFlag = SPM_ERR_MEMORY;
+        return;
+    }
+    if (procMgr->frameBuf->capacity != capacity) procMgr->engineStats.allocations++;
+    writeFrameData(procMgr, frame, elapsed);
+}
 
-        // transfer processes up to 'i' seconds from unstarted to queue
-        transferProcessesUpToStartTime(&procMgr->unstarted, &procMgr->queue, i);
+// returns 1 if any process has not finished yet, 0 otherwise
+int hasPendingProcesses(ProcessManager* procMgr) {
 
-        // add run time to all running processes; terminate finished processes
-        ProcessNode* curNode = procMgr->active.head;
-        while (curNode != NULL) {
-            if (--curNode->process.remainingTime <= 0)
-                removeProcess(&procMgr->active, curNode);
-            curNode = curNode->next;
-        }
+    return procMgr->active.size > 0 || getQueueSize(procMgr) > 0 || procMgr->unstarted.head != NULL;
+}
 
-        // add queued processes to active in fifo order (for as many free CPUs while queue is not empty)
-        for (int j = 0; j < procMgr->numCpus - procMgr->active.size && procMgr->queue.head != NULL; j++) {
-            addProcessBack(&procMgr->active, procMgr->queue.tail->process);
-            removeProcessBack(&procMgr->queue);
-        }
+// emits the frame for the current event and every idle second up to (but not including) the next event
+// nothing changes between events, so those frames only differ by the elapsed run time of active processes
+void addFramesUntil(ProcessManager* procMgr, unsigned long long time, unsigned long long nextTime) {
 
-        // add frame to frame string
-        addFrame(procMgr, frameStr);
+    // frames are optional; skip straight to the next event if not requested
+    if (procMgr->frameStr == NULL && procMgr->frameBuf == NULL) return;
 
-        // if error flag is set, fail and return
-        if (procMgr->errFlag)
-            return;
+    // the frame at the current event is always emitted; idle seconds only while something is left to simulate
+    unsigned long long lastTime = hasPendingProcesses(procMgr) ? nextTime - 1 : time;
+
+    // write frames (stop on error)
+    START_PHASE(frame);
+    for (unsigned long long i = time; i <= lastTime && !procMgr->errFlag; i++) {
+        if (procMgr->frameStr != NULL) addFrame(procMgr, i - time);
+        if (procMgr->frameBuf != NULL) addFrameData(procMgr, i - time);
+        procMgr->engineStats.framesEmitted++;
     }
+    END_PHASE(procMgr, frame);
 }
 
-void doRR(ProcessManager* procMgr, char* frameStr) {
+// opens an execution interval for a process dispatched at the current event (interval output only)
+// per-CPU run queues dispatch to 'cpu'; with the global queue, the process takes the lowest free CPU until it leaves
+void openInterval(ProcessManager* procMgr, ProcessNode* procNode, unsigned int cpu) {
 
-    // begin loop
-    for (int i = 0; i <= MAX_TIME_AND_PID && (procMgr->active.head != NULL || procMgr->queue.head != NULL || procMgr->unstarted.head != NULL); i++) {
+    IntervalBuffer* intervals = procMgr->intervals;
+    unsigned int capacity = intervals->capacity;
+    unsigned int* interval = reserveInterval(intervals);
+    if (interval == NULL) {
+        procMgr->errFlag = SPM_ERR_MEMORY;
+        return;
+    }
+    if (intervals->capacity != capacity) procMgr->engineStats.allocations++;
 
-        // transfer processes up to 'i' seconds from unstarted to queue
-        transferProcessesUpToStartTime(&procMgr->unstarted, &procMgr->queue, i);
+    // place and write interval (ends when the process leaves its CPU; per-CPU queues track the CPU themselves)
+    if (procMgr->runQueues == NULL) {
+        cpu = claimFreeCpu(intervals);
+        procNode->cpu = cpu;
+    }
+    procNode->interval = intervals->numIntervals - 1;
+    interval[0] = cpu;
+    interval[1] = procNode->process.pid;
+    interval[2] = procMgr->time;
+    interval[3] = INTERVAL_OPEN;
+    interval[4] = procNode->process.remainingTime;
+}
 
-        // add run time to all running processes; terminate finished processes; move rr processes back to queue for as many queued processes that exist
-        ProcessNode* curNode = procMgr->active.head;
-        unsigned int rrToQueue = procMgr->queue.size; // max num of processes to queue
-        while (curNode != NULL) {
+// ends a process's execution interval at the current event (it completed, was requeued or was preempted)
+void closeInterval(ProcessManager* procMgr, ProcessNode* procNode) {
 
-            // terminate finished processes
-            if (--curNode->process.remainingTime <= 0) {
-                removeProcess(&procMgr->active, curNode);
-            }
+    IntervalBuffer* intervals = procMgr->intervals;
+    intervals->data[INTERVAL_WORDS * procNode->interval + 3] = procMgr->time;
+    if (procMgr->runQueues == NULL) releaseCpu(intervals, procNode->cpu);
+}
 
-            // reset rr and move back to queue for up to as many queue items that exist
-            else if (++curNode->process.rrTime >= procMgr->rrQuantum) {
-                curNode->process.rrTime = 0;
-                if (rrToQueue > 0) {
-                    addProcessBack(&procMgr->queue, curNode->process);
-                    removeProcess(&procMgr->active, curNode);
-                    rrToQueue--;
-                }
-            }
-            curNode = curNode->next;
-        }
+// records the queue length after an event and the seconds the run spans so far (same count as addFramesUntil emits)
+void recordIntervalEvent(ProcessManager* procMgr) {
+
+    IntervalBuffer* intervals = procMgr->intervals;
+    if (procMgr->time >= INTERVAL_OPEN) {
+        procMgr->errFlag = SPM_ERR_LIMIT;
+        return;
+    }
+    if (addQueuePoint(intervals, procMgr->time, getQueueSize(procMgr))) {
+        procMgr->errFlag = SPM_ERR_MEMORY;
+        return;
+    }
+    intervals->numFrames = hasPendingProcesses(procMgr) ? procMgr->nextTime : procMgr->time + 1;
+}
+
+// scheduling policy: the hooks one generic event handler is specialized with
+// each algorithm passes a constant policy to the always inlined handler, so its hooks compile straight into that algorithm's loop
+typedef struct SchedPolicy {
+
+    ProcessNode* (*selectProcess)(ProcessList* queue, ProcessHeap* queueHeap, ProcessLevels* queueLevels); // next process to dispatch from a queue (queue is not empty)
+    char indexesQueue;  // queued processes are indexed by remaining time (queueHeap)
+    char indexesLevels; // queued processes are indexed by feedback level (queueLevels); a higher level preempts, and expiry demotes
+    char hasQuantum;    // running processes go back to the queue when their quantum expires
+    char preempts;      // a queued process shorter than the longest running one preempts it (activeHeap indexes completion times)
+    char perCpu;       // per-CPU run queues instead of the global queue (chosen at run time, but each model gets its own loop)
+
+} SchedPolicy;
 
-        // add queued processes to active in fifo order (for as many free CPUs while queue is not empty)
-        for (int j = 0; j < procMgr->numCpus - procMgr->active.size && procMgr->queue.head != NULL; j++) {
-            addProcessBack(&procMgr->active, procMgr->queue.tail->process);
-            removeProcessBack(&procMgr->queue);
+// selection hooks
+SPM_INLINE ProcessNode* selectOldest(ProcessList* queue, ProcessHeap* queueHeap, ProcessLevels* queueLevels) {
+
+    return queue->head;
+}
+
+SPM_INLINE ProcessNode* selectNewest(ProcessList* queue, ProcessHeap* queueHeap, ProcessLevels* queueLevels) {
+
+    return queue->tail;
+}
+
+SPM_INLINE ProcessNode* selectIndexed(ProcessList* queue, ProcessHeap* queueHeap, ProcessLevels* queueLevels) {
+
+    return popProcessHeap(queueHeap);
+}
+
+SPM_INLINE ProcessNode* selectLeveled(ProcessList* queue, ProcessHeap* queueHeap, ProcessLevels* queueLevels) {
+
+    return popProcessLevels(queueLevels);
+}
+
+// policies (a new algorithm needs an enum value, a policy here and a case in runAlgorithmEvent and runAlgorithmLoop)
+#define FIFO_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectOldest, .perCpu = isPerCpu })
+#define LIFO_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectNewest, .perCpu = isPerCpu })
+#define RR_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectOldest, .hasQuantum = 1, .perCpu = isPerCpu })
+#define SJF_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectIndexed, .indexesQueue = 1, .perCpu = isPerCpu }) // min heap
+#define LJF_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectIndexed, .indexesQueue = 1, .perCpu = isPerCpu }) // max heap
+#define SRTF_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectIndexed, .indexesQueue = 1, .preempts = 1, .perCpu = isPerCpu })
+#define MLFQ_POLICY(isPerCpu) ((SchedPolicy){ .selectProcess = selectLeveled, .indexesLevels = 1, .hasQuantum = 1, .perCpu = isPerCpu })
+
+// quantum the running set counts against (MLFQ counts every level against its longest one; see getLevelRrTime)
+SPM_INLINE unsigned int getPolicyQuantum(ProcessManager* procMgr, const SchedPolicy policy) {
+
+    return policy.indexesLevels ? getLevelQuantum(procMgr->rrQuantum, MLFQ_LEVELS - 1) : procMgr->rrQuantum;
+}
+
+// records a finished process (it finishes exactly at the current event)
+void completeProcess(ProcessManager* procMgr, ProcessNode* procNode) {
+
+    if (procMgr->stats != NULL)
+        recordCompletion(procMgr->stats, procMgr->time, procNode->process.startTime, procNode->process.duration);
+}
+
+// moves a process that left the running set to the back of the queue (indexed if the policy selects by remaining time)
+// with per-CPU run queues, that is the queue of the CPU it ran on (the caller marks the CPU idle)
+SPM_INLINE void requeueProcess(ProcessManager* procMgr, ProcessNode* procNode, const SchedPolicy policy) {
+
+    if (procMgr->stats != NULL) recordPreemption(procMgr->stats);
+    procMgr->engineStats.nodeMoves++;
+    if (policy.perCpu) {
+        if (addRunQueueProcess(procMgr->runQueues, procNode->cpu, procNode, policy.indexesQueue, policy.indexesLevels))
+            procMgr->errFlag = SPM_ERR_MEMORY;
+        return;
+    }
+
+    linkProcessBack(&procMgr->queue, procNode);
+    if (policy.indexesQueue && pushProcessHeap(&procMgr->queueHeap, procNode, procNode->process.remainingTime))
+        procMgr->errFlag = SPM_ERR_MEMORY;
+    if (policy.indexesLevels && pushProcessLevels(&procMgr->queueLevels, procNode))
+        procMgr->errFlag = SPM_ERR_MEMORY;
+}
+
+// runs active processes for the seconds elapsed since the previous event; terminates finished processes
+// with a quantum, also moves expired processes back to the queue (for as many queued processes that exist)
+// with feedback levels, an expired process is demoted first, and only goes back if a waiting process has at least its new priority
+SPM_INLINE void advanceActive(ProcessManager* procMgr, unsigned long long elapsed, const SchedPolicy policy) {
+
+    // add run (and rr) time to all processes at once; done unless one finished or used up its quantum
+    ActiveSet* active = &procMgr->active;
+    if (active->size == 0) return;
+    unsigned int quantum = getPolicyQuantum(procMgr, policy);
+    unsigned int first = tickActiveSet(active, elapsed, quantum, policy.hasQuantum);
+    if (first == active->size) return;
+
+    // terminate finished processes (and drop them from the preemption index); requeue expired ones
+    unsigned int rrToQueue = procMgr->queue.size; // max num of processes to queue
+    for (unsigned int i = first; i < active->size; i++) {
+        ProcessNode* curNode = active->nodes[i];
+
+        // terminate finished processes (freeing their CPU)
+        if (active->remainingTime[i] == 0) {
+            curNode->process.remainingTime = 0;
+            completeProcess(procMgr, curNode);
+            if (procMgr->intervals != NULL) closeInterval(procMgr, curNode);
+            if (policy.perCpu) setCpuProcess(procMgr->runQueues, curNode->cpu, NULL);
+            else if (policy.preempts) removeProcessHeap(&procMgr->activeHeap, curNode);
+            else if (policy.indexesLevels) removeRunningLevel(&procMgr->activeLevels, curNode->process.level);
+            releaseProcessNode(&procMgr->pool, curNode);
+            procMgr->engineStats.nodeMoves++;
+            active->nodes[i] = NULL;
         }
 
-        // add frame to frame string
-        addFrame(procMgr, frameStr);
+        // reset rr and move back to queue for up to as many queue items that exist (per-CPU: only if its own CPU has waiting processes)
+        else if (policy.hasQuantum && active->rrTime[i] >= quantum) {
+            unsigned int prevLevel = curNode->process.level;
+            char isWaiting = policy.perCpu ? procMgr->runQueues->queues[curNode->cpu].head != NULL : rrToQueue > 0;
+            active->rrTime[i] = 0;
+
+            // feedback levels: demote (starting the next level's quantum); waiting processes of lower priority do not take the CPU
+            if (policy.indexesLevels) {
+                if (curNode->process.level < MLFQ_LEVELS - 1) curNode->process.level++;
+                active->rrTime[i] = getLevelRrTime(procMgr->rrQuantum, curNode->process.level);
+                if (isWaiting)
+                    isWaiting = peekProcessLevel(policy.perCpu ? &procMgr->runQueues->levels[curNode->cpu] : &procMgr->queueLevels) <= curNode->process.level;
+                if (!policy.perCpu) removeRunningLevel(&procMgr->activeLevels, prevLevel);
+                if (!policy.perCpu && !isWaiting) addRunningLevel(&procMgr->activeLevels, curNode->process.level);
+            }
 
-        // if error flag is set, fail and return
-        if (procMgr->errFlag)
-            return;
+            if (isWaiting) {
+                if (procMgr->intervals != NULL) closeInterval(procMgr, curNode);
+                curNode->process.remainingTime = active->remainingTime[i];
+                curNode->process.rrTime = active->rrTime[i];
+                active->nodes[i] = NULL;
+                if (policy.perCpu) setCpuProcess(procMgr->runQueues, curNode->cpu, NULL);
+                requeueProcess(procMgr, curNode, policy);
+                rrToQueue--;
+            }
+        }
     }
+
+    // close the gaps in order
+    compactActiveSet(active, first);
 }
 
-void doSJF(ProcessManager* procMgr, char* frameStr) {
+// returns the time of the next arrival, completion, quantum expiry or (with feedback levels) boost after 'time' (ULLONG_MAX if there is none)
+SPM_INLINE unsigned long long getNextEventTime(ProcessManager* procMgr, unsigned long long time, const SchedPolicy policy) {
 
-    // begin loop
-    for (int i = 0; i <= MAX_TIME_AND_PID && (procMgr->active.head != NULL || procMgr->queue.head != NULL || procMgr->unstarted.head != NULL); i++) {
+    // next arrival (unstarted processes are sorted by start time)
+    unsigned long long nextTime = ULLONG_MAX;
+    if (procMgr->unstarted.head != NULL)
+        nextTime = procMgr->unstarted.head->process.startTime;
 
-        // transfer processes up to 'i' seconds from unstarted to queue
-        transferProcessesUpToStartTime(&procMgr->unstarted, &procMgr->queue, i);
+    // next completion or quantum expiry (a process always runs for at least one second)
+    if (procMgr->active.size > 0) {
+        unsigned int runTime = getActiveRunTime(&procMgr->active, getPolicyQuantum(procMgr, policy), policy.hasQuantum);
+        if (runTime == 0) runTime = 1;
+        if (time + runTime < nextTime)
+            nextTime = time + runTime;
+    }
 
-        // add run time to all running processes; terminate finished processes
-        ProcessNode* curNode = procMgr->active.head;
-        while (curNode != NULL) {
-            if (--curNode->process.remainingTime <= 0)
-                removeProcess(&procMgr->active, curNode);
-            curNode = curNode->next;
-        }
+    // next boost (boosts fall on multiples of the boost period, and only matter while processes run or wait)
+    if (policy.indexesLevels && (procMgr->active.size > 0 || getQueueSize(procMgr) > 0)) {
+        unsigned long long boostPeriod = getBoostPeriod(procMgr->rrQuantum);
+        unsigned long long boostTime = (time / boostPeriod + 1) * boostPeriod;
+        if (boostTime < nextTime)
+            nextTime = boostTime;
+    }
 
-        // add queued processes to active by shortest duration first (for as many free CPUs while queue is not empty)
-        for (int j = 0; j < procMgr->numCpus - procMgr->active.size && procMgr->queue.head != NULL; j++) {
+    return nextTime;
+}
 
-            // loop to find shortest process node
-            curNode = procMgr->queue.head->next;
-            ProcessNode* minProcNode = procMgr->queue.head;
-            while (curNode != NULL) {
-                if (curNode->process.remainingTime < minProcNode->process.remainingTime)
-                    minProcNode = curNode;
-                curNode = curNode->next;
+// transfers processes up to 'time' seconds from unstarted to queue; indexes them if the policy selects by remaining time
+// with per-CPU run queues, arrivals are dealt out to the CPUs in turn; returns the number of processes admitted
+SPM_INLINE unsigned int admitProcesses(ProcessManager* procMgr, unsigned long long time, const SchedPolicy policy) {
+
+    // per-CPU: place each arrival on the next CPU's run queue
+    if (policy.perCpu) {
+        RunQueues* runQueues = procMgr->runQueues;
+        unsigned int numAdmitted = 0;
+        while (procMgr->unstarted.head != NULL && procMgr->unstarted.head->process.startTime <= time) {
+            ProcessNode* curNode = procMgr->unstarted.head;
+            unlinkProcess(&procMgr->unstarted, curNode);
+            if (policy.indexesLevels) curNode->process.rrTime = getLevelRrTime(procMgr->rrQuantum, 0);
+            if (addRunQueueProcess(runQueues, runQueues->nextCpu, curNode, policy.indexesQueue, policy.indexesLevels)) {
+                procMgr->errFlag = SPM_ERR_MEMORY;
+                return numAdmitted;
             }
+            if (++runQueues->nextCpu == runQueues->numCpus) runQueues->nextCpu = 0;
+            numAdmitted++;
+        }
+        procMgr->engineStats.nodeMoves += numAdmitted;
+        return numAdmitted;
+    }
 
-            // move process from queue to active
-            addProcessBack(&procMgr->active, minProcNode->process);
-            removeProcess(&procMgr->queue, minProcNode);
+    // transfer processes (appended to queue in start time order)
+    unsigned int prevSize = procMgr->queue.size;
+    transferProcessesUpToStartTime(&procMgr->unstarted, &procMgr->queue, time);
+    procMgr->engineStats.nodeMoves += procMgr->queue.size - prevSize;
+    if (!(policy.indexesQueue || policy.indexesLevels) || procMgr->queue.size == prevSize) return procMgr->queue.size - prevSize;
+
+    // find first transferred node
+    procMgr->engineStats.queueScans++;
+    ProcessNode* curNode = procMgr->queue.tail;
+    for (unsigned int i = prevSize + 1; i < procMgr->queue.size; i++)
+        curNode = curNode->prev;
+
+    // index transferred nodes in order (so ties keep start time order); feedback levels start them at the top level
+    unsigned int rrTime = getLevelRrTime(procMgr->rrQuantum, 0);
+    for (unsigned int i = prevSize; i < procMgr->queue.size; i++) {
+        if (policy.indexesLevels) curNode->process.rrTime = rrTime;
+        if (policy.indexesLevels ? pushProcessLevels(&procMgr->queueLevels, curNode) : pushProcessHeap(&procMgr->queueHeap, curNode, curNode->process.remainingTime)) {
+            procMgr->errFlag = SPM_ERR_MEMORY;
+            break;
         }
+        curNode = curNode->next;
+    }
+    return procMgr->queue.size - prevSize;
+}
 
-        // add frame to frame string
-        addFrame(procMgr, frameStr);
+// moves a queued process to active (indexing its completion time if the policy preempts)
+// with per-CPU run queues, it leaves the run queue it waits in (its own or a stolen one) and runs on 'cpu'
+SPM_INLINE void dispatchProcess(ProcessManager* procMgr, ProcessNode* procNode, unsigned int cpu, const SchedPolicy policy) {
+
+    procMgr->numDecisions++;
+    procMgr->engineStats.nodeMoves++;
+    if (procMgr->stats != NULL)
+        recordDispatch(procMgr->stats, procMgr->time, procNode->process.startTime, procNode->process.remainingTime == procNode->process.duration);
+    addActiveProcess(&procMgr->active, procNode);
+    if (procMgr->intervals != NULL) openInterval(procMgr, procNode, cpu);
+
+    // per-CPU: the CPU's completion time stands in for the preemption index
+    if (policy.perCpu) {
+        removeRunQueueProcess(procMgr->runQueues, procNode);
+        setCpuProcess(procMgr->runQueues, cpu, procNode);
+        if (policy.preempts)
+            procMgr->runQueues->completionTime[cpu] = procMgr->time + procNode->process.remainingTime;
+        return;
+    }
 
-        // if error flag is set, fail and return
-        if (procMgr->errFlag)
-            return;
+    unlinkProcess(&procMgr->queue, procNode);
+    if (policy.preempts && pushProcessHeap(&procMgr->activeHeap, procNode, procMgr->time + procNode->process.remainingTime))
+        procMgr->errFlag = SPM_ERR_MEMORY;
+    if (policy.indexesLevels) addRunningLevel(&procMgr->activeLevels, procNode->process.level);
+}
+
+// fills idle CPUs with per-CPU run queues: first each from its own queue, then the rest steal from other CPUs' queues
+// CPUs are visited lowest first and victims are chosen by position, so the same input always balances the same way
+SPM_INLINE void dispatchRunQueues(ProcessManager* procMgr, const SchedPolicy policy) {
+
+    // run local work on idle CPUs that have some
+    RunQueues* runQueues = procMgr->runQueues;
+    unsigned int cpu = findNextReadyCpu(runQueues, 0);
+    procMgr->engineStats.queueScans++;
+    while (cpu < runQueues->numCpus && !procMgr->errFlag) {
+        dispatchProcess(procMgr, policy.selectProcess(&runQueues->queues[cpu], &runQueues->heaps[cpu], policy.indexesLevels ? &runQueues->levels[cpu] : NULL), cpu, policy);
+        cpu = findNextReadyCpu(runQueues, cpu + 1);
+        procMgr->engineStats.queueScans++;
+    }
+
+    // remaining idle CPUs have empty queues; each steals one process while any are waiting
+    cpu = 0;
+    while (runQueues->numQueued > 0 && !procMgr->errFlag) {
+        cpu = findNextCpu(runQueues->idleMask, runQueues->numCpus, cpu);
+        procMgr->engineStats.queueScans++;
+        if (cpu == runQueues->numCpus) return;
+        unsigned int victim = findStealVictim(runQueues, cpu);
+        procMgr->engineStats.queueScans++;
+        dispatchProcess(procMgr, policy.selectProcess(&runQueues->queues[victim], &runQueues->heaps[victim], policy.indexesLevels ? &runQueues->levels[victim] : NULL), cpu, policy);
+        runQueues->numSteals++;
+        cpu++;
     }
 }
 
-void doLJF(ProcessManager* procMgr, char* frameStr) {
+// preempts the longest running process while a shorter one is waiting (only arrivals can make this happen)
+// active remaining times live in the running set, but the longest one is also its completion time minus now
+SPM_INLINE void preemptLongest(ProcessManager* procMgr, const SchedPolicy policy) {
 
-    // begin loop
-    for (int i = 0; i <= MAX_TIME_AND_PID && (procMgr->active.head != NULL || procMgr->queue.head != NULL || procMgr->unstarted.head != NULL); i++) {
+    while (procMgr->queueHeap.size > 0 && procMgr->activeHeap.size > 0 && !procMgr->errFlag &&
+        peekProcessHeap(&procMgr->queueHeap)->process.remainingTime < peekProcessHeapKey(&procMgr->activeHeap) - procMgr->time) {
 
-        // transfer processes up to 'i' seconds from unstarted to queue
-        transferProcessesUpToStartTime(&procMgr->unstarted, &procMgr->queue, i);
+        // move longest running process back to queue
+        ProcessNode* preemptedNode = popProcessHeap(&procMgr->activeHeap);
+        procMgr->engineStats.queueScans++;
+        removeActiveProcess(&procMgr->active, findActiveProcess(&procMgr->active, preemptedNode));
+        if (procMgr->intervals != NULL) closeInterval(procMgr, preemptedNode);
+        requeueProcess(procMgr, preemptedNode, policy);
 
-        // add run time to all running processes; terminate finished processes
-        ProcessNode* curNode = procMgr->active.head;
-        while (curNode != NULL) {
-            if (--curNode->process.remainingTime <= 0)
-                removeProcess(&procMgr->active, curNode);
-            curNode = curNode->next;
+        // move shortest waiting process to active
+        if (!procMgr->errFlag)
+            dispatchProcess(procMgr, policy.selectProcess(&procMgr->queue, &procMgr->queueHeap, &procMgr->queueLevels), 0, policy);
+    }
+}
+
+// preempts the lowest priority running process while a higher priority one is waiting (arrivals and boosts can make this happen)
+// the running levels give the lowest priority at once; the victim is the last dispatched process at it
+SPM_INLINE void preemptLowest(ProcessManager* procMgr, const SchedPolicy policy) {
+
+    while (procMgr->queueLevels.size > 0 && procMgr->active.size > 0 && !procMgr->errFlag &&
+        peekProcessLevel(&procMgr->queueLevels) < getLowestRunningLevel(&procMgr->activeLevels)) {
+
+        // move newest running process of the lowest priority back to queue
+        unsigned int level = getLowestRunningLevel(&procMgr->activeLevels);
+        unsigned int index = procMgr->active.size - 1;
+        while (procMgr->active.nodes[index]->process.level != level) index--;
+        procMgr->engineStats.queueScans++;
+        ProcessNode* preemptedNode = removeActiveProcess(&procMgr->active, index);
+        removeRunningLevel(&procMgr->activeLevels, level);
+        if (procMgr->intervals != NULL) closeInterval(procMgr, preemptedNode);
+        requeueProcess(procMgr, preemptedNode, policy);
+
+        // move highest priority waiting process to active
+        if (!procMgr->errFlag)
+            dispatchProcess(procMgr, policy.selectProcess(&procMgr->queue, &procMgr->queueHeap, &procMgr->queueLevels), 0, policy);
+    }
+}
+
+// preemption with per-CPU run queues: an arrival only competes with the process on the CPU it was placed on
+// this event's 'numAdmitted' arrivals went to the CPUs in turn from 'firstCpu', so only those CPUs are checked (feedback levels compare levels instead of times)
+SPM_INLINE void preemptRunQueues(ProcessManager* procMgr, unsigned int firstCpu, unsigned int numAdmitted, const SchedPolicy policy) {
+
+    RunQueues* runQueues = procMgr->runQueues;
+    if (numAdmitted > runQueues->numCpus) numAdmitted = runQueues->numCpus;
+    unsigned int cpu = firstCpu;
+    for (unsigned int i = 0; i < numAdmitted && !procMgr->errFlag; i++) {
+
+        // swap the running process for the shortest (or highest priority) waiting one if that is shorter (or higher)
+        ProcessNode* runNode = runQueues->running[cpu];
+        ProcessHeap* heap = &runQueues->heaps[cpu];
+        ProcessLevels* levels = policy.indexesLevels ? &runQueues->levels[cpu] : NULL;
+        if (runNode != NULL && (policy.indexesLevels ? peekProcessLevel(levels) < runNode->process.level :
+            heap->size > 0 && peekProcessHeap(heap)->process.remainingTime < runQueues->completionTime[cpu] - procMgr->time)) {
+            procMgr->engineStats.queueScans++;
+            removeActiveProcess(&procMgr->active, findActiveProcess(&procMgr->active, runNode));
+            if (procMgr->intervals != NULL) closeInterval(procMgr, runNode);
+            setCpuProcess(runQueues, cpu, NULL);
+            requeueProcess(procMgr, runNode, policy);
+            if (!procMgr->errFlag)
+                dispatchProcess(procMgr, policy.selectProcess(&runQueues->queues[cpu], heap, levels), cpu, policy);
         }
 
-        // add queued processes to active by shortest duration first (for as many free CPUs while queue is not empty)
-        for (int j = 0; j < procMgr->numCpus - procMgr->active.size && procMgr->queue.head != NULL; j++) {
+        if (++cpu == runQueues->numCpus) cpu = 0;
+    }
+}
 
-            // loop to find shortest process node
-            curNode = procMgr->queue.head->next;
-            ProcessNode* maxProcNode = procMgr->queue.head;
-            while (curNode != NULL) {
-                if (curNode->process.remainingTime > maxProcNode->process.remainingTime)
-                    maxProcNode = curNode;
-                curNode = curNode->next;
-            }
+// moves a waiting list's processes below the top level back to it with a new quantum, re-indexing the list in queue order
+static void boostQueue(ProcessManager* procMgr, ProcessList* queue, ProcessLevels* queueLevels, unsigned int rrTime) {
+
+    // nothing to do if every waiting process is at the top level already
+    if ((queueLevels->readyMask & ~1ull) == 0) return;
+    procMgr->engineStats.queueScans++;
+    clearProcessLevels(queueLevels);
+    for (ProcessNode* curNode = queue->head; curNode != NULL; curNode = curNode->next) {
+        if (curNode->process.level != 0) {
+            curNode->process.level = 0;
+            curNode->process.rrTime = rrTime;
+        }
+        if (pushProcessLevels(queueLevels, curNode)) {
+            procMgr->errFlag = SPM_ERR_MEMORY;
+            return;
+        }
+    }
+}
 
-            // move process from queue to active
-            addProcessBack(&procMgr->active, maxProcNode->process);
-            removeProcess(&procMgr->queue, maxProcNode);
+// boost: every process below the top level returns to it (running ones in place), so demoted processes cannot starve
+// waiting processes are re-indexed in queue order, which costs O(waiting) once per boost period rather than anything per selection
+SPM_INLINE void boostLevels(ProcessManager* procMgr, const SchedPolicy policy) {
+
+    // running processes
+    unsigned int rrTime = getLevelRrTime(procMgr->rrQuantum, 0);
+    ActiveSet* active = &procMgr->active;
+    for (unsigned int i = 0; i < active->size; i++) {
+        ProcessNode* curNode = active->nodes[i];
+        if (curNode->process.level == 0) continue;
+        if (!policy.perCpu) {
+            removeRunningLevel(&procMgr->activeLevels, curNode->process.level);
+            addRunningLevel(&procMgr->activeLevels, 0);
         }
+        curNode->process.level = 0;
+        active->rrTime[i] = rrTime;
+    }
 
-        // add frame to frame string
-        addFrame(procMgr, frameStr);
+    // waiting processes
+    if (!policy.perCpu) {
+        boostQueue(procMgr, &procMgr->queue, &procMgr->queueLevels, rrTime);
+        return;
+    }
+    RunQueues* runQueues = procMgr->runQueues;
+    for (unsigned int cpu = findNextCpu(runQueues->queuedMask, runQueues->numCpus, 0); cpu < runQueues->numCpus && !procMgr->errFlag;
+        cpu = findNextCpu(runQueues->queuedMask, runQueues->numCpus, cpu + 1))
+        boostQueue(procMgr, &runQueues->queues[cpu], &runQueues->levels[cpu], rrTime);
+}
 
-        // if error flag is set, fail and return
-        if (procMgr->errFlag)
-            return;
+// handles the event at the current time, then finds the next event (the one loop every policy shares)
+SPM_INLINE void handleEvent(ProcessManager* procMgr, const SchedPolicy policy) {
+
+    // transfer processes up to the current event from unstarted to queue
+    procMgr->engineStats.events++;
+    START_PHASE(arrival);
+    unsigned long long time = procMgr->time;
+    if (procMgr->readArrivals != NULL) refillArrivals(procMgr, time);
+    unsigned int firstCpu = policy.perCpu ? procMgr->runQueues->nextCpu : 0;
+    unsigned int numAdmitted = admitProcesses(procMgr, time, policy);
+    END_PHASE(procMgr, arrival);
+
+    // add run time to all running processes; terminate finished processes (and requeue expired ones)
+    START_PHASE(tick);
+    advanceActive(procMgr, time - procMgr->prevTime, policy);
+    END_PHASE(procMgr, tick);
+
+    // return every process to the top level once per boost period
+    if (policy.indexesLevels && time % getBoostPeriod(procMgr->rrQuantum) == 0)
+        boostLevels(procMgr, policy);
+
+    // add queued processes to active in policy order (for as many free CPUs while queue is not empty)
+    START_PHASE(dispatch);
+    if (policy.perCpu)
+        dispatchRunQueues(procMgr, policy);
+    else while (procMgr->active.size < procMgr->numCpus && procMgr->queue.head != NULL && !procMgr->errFlag)
+        dispatchProcess(procMgr, policy.selectProcess(&procMgr->queue, &procMgr->queueHeap, &procMgr->queueLevels), 0, policy);
+
+    // let shorter (or higher priority) arrivals preempt
+    if ((policy.preempts || policy.indexesLevels) && policy.perCpu)
+        preemptRunQueues(procMgr, firstCpu, numAdmitted, policy);
+    else if (policy.preempts)
+        preemptLongest(procMgr, policy);
+    else if (policy.indexesLevels)
+        preemptLowest(procMgr, policy);
+
+    // find the next event
+    procMgr->nextTime = getNextEventTime(procMgr, time, policy);
+    END_PHASE(procMgr, dispatch);
+
+    // interval output changes only here and at dispatches and departures (no per-second work)
+    if (procMgr->intervals != NULL && !procMgr->errFlag)
+        recordIntervalEvent(procMgr);
+}
+
+// handles one event with the configured algorithm and queue model
+SPM_INLINE void runAlgorithmEvent(ProcessManager* procMgr, const char isPerCpu) {
+
+    switch(procMgr->alg) {
+        case FIFO:
+            handleEvent(procMgr, FIFO_POLICY(isPerCpu));
+            break;
+        case LIFO:
+            handleEvent(procMgr, LIFO_POLICY(isPerCpu));
+            break;
+        case RR:
+            handleEvent(procMgr, RR_POLICY(isPerCpu));
+            break;
+        case SJF:
+            handleEvent(procMgr, SJF_POLICY(isPerCpu));
+            break;
+        case LJF:
+            handleEvent(procMgr, LJF_POLICY(isPerCpu));
+            break;
+        case SRTF:
+            handleEvent(procMgr, SRTF_POLICY(isPerCpu));
+            break;
+        case MLFQ:
+            handleEvent(procMgr, MLFQ_POLICY(isPerCpu));
+            break;
+        default:
+            procMgr->errFlag = SPM_ERR_SETTINGS;
+            break;
     }
 }
 
-char* getFrames(char* str) {
+// handles the event at the current time with the configured algorithm, then finds the next event
+void runEvent(ProcessManager* procMgr) {
 
-    // create new process manager from parsed data
-    ProcessManager* procMgr = parseManagerFromString(str);
-    if (procMgr == NULL) {
-        fputs("ERROR: could not generate process manager", stderr);
-        return "ECould not generate process manager, likely due to memory allocation or internal parsing error";
+    if (procMgr->runQueues != NULL)
+        runAlgorithmEvent(procMgr, 1);
+    else
+        runAlgorithmEvent(procMgr, 0);
+}
+
+// jumps the clock to the next event (nothing can change between events)
+void advanceClock(ProcessManager* procMgr) {
+
+    procMgr->prevTime = procMgr->time;
+    procMgr->time = procMgr->nextTime;
+}
+
+// snapshots the running set, the queue and the clock right after an event was handled (before its frames)
+void recordCheckpoint(ProcessManager* procMgr) {
+
+    // allocate snapshot (one spare entry so an empty one is not a null allocation; a failed snapshot is skipped, the run does not depend on it)
+    Checkpoint checkpoint = {
+        .time = procMgr->time,
+        .prevTime = procMgr->prevTime,
+        .numDecisions = procMgr->numDecisions,
+        .frameSize = procMgr->frameBuf != NULL ? procMgr->frameBuf->size : 0,
+        .numFrames = procMgr->frameBuf != NULL ? procMgr->frameBuf->numFrames : 0,
+        .numIntervals = procMgr->intervals != NULL ? procMgr->intervals->numIntervals : 0,
+        .numQueuePoints = procMgr->intervals != NULL ? procMgr->intervals->numQueuePoints : 0,
+        .firstOpenInterval = procMgr->intervals != NULL ? procMgr->intervals->numIntervals : 0,
+        .numActive = procMgr->active.size,
+        .numQueued = procMgr->queue.size
+    };
+    checkpoint.processes = malloc(sizeof(Process) * (checkpoint.numActive + checkpoint.numQueued + 1));
+    if (checkpoint.processes == NULL) {
+        procMgr->checkpoints->numEvents = 0;
+        return;
     }
-    puts("PARSED INPUT");
-    printf("numCpus: %d, alg: %d, rrTime: %d\n", procMgr->numCpus, procMgr->alg, procMgr->rrQuantum);
+    procMgr->engineStats.allocations++;
+
+    // running processes (their times live in the running set), then queued ones in order
+    Process* process = checkpoint.processes;
+    for (unsigned int i = 0; i < procMgr->active.size; i++) {
+        *process = procMgr->active.nodes[i]->process;
+        process->remainingTime = procMgr->active.remainingTime[i];
+        process->rrTime = procMgr->active.rrTime[i];
+        process++;
+        if (procMgr->intervals != NULL && procMgr->active.nodes[i]->interval < checkpoint.firstOpenInterval)
+            checkpoint.firstOpenInterval = procMgr->active.nodes[i]->interval;
+    }
+    for (ProcessNode* curNode = procMgr->queue.head; curNode != NULL; curNode = curNode->next)
+        *process++ = curNode->process;
 
-    // sort unstarted processes by start time and loop through process nodes
-    sortProcessList(&procMgr->unstarted);
-    ProcessNode* curNode = procMgr->unstarted.head;
-    while (curNode != NULL) {
-        printf("\tpid: %d, startTime: %d, duration: %d\n", curNode->process.pid, curNode->process.startTime, curNode->process.remainingTime);
-        curNode = curNode->next;
+    addCheckpoint(procMgr->checkpoints, checkpoint);
+}
+
+// runs a policy to completion (the clock stays at the last event, i.e. when the last process finished)
+SPM_INLINE void runPolicy(ProcessManager* procMgr, const SchedPolicy policy) {
+
+    // begin event loop
+    while (hasPendingProcesses(procMgr)) {
+        handleEvent(procMgr, policy);
+
+        // snapshot every few events (checkpointed runs only)
+        if (procMgr->checkpoints != NULL && ++procMgr->checkpoints->numEvents >= procMgr->checkpoints->interval)
+            recordCheckpoint(procMgr);
+
+        // add frames up to the next event to frame string
+        addFramesUntil(procMgr, procMgr->time, procMgr->nextTime);
+
+        // if error flag is set, fail and return
+        if (procMgr->errFlag)
+            return;
+
+        if (hasPendingProcesses(procMgr))
+            advanceClock(procMgr);
     }
+}
 
-    // create string
-    char* frameStr = malloc(sizeof(char) * (MAX_FULL_FRAME_STR_LEN + 1));
-    if (frameStr == NULL) return "ECould not allocate frame string";
+// runs the configured algorithm with a queue model to completion (each case is a loop specialized for its policy)
+SPM_INLINE void runAlgorithmLoop(ProcessManager* procMgr, const char isPerCpu) {
 
-    // run algorithm
     switch(procMgr->alg) {
         case FIFO:
-            doFIFO(procMgr, frameStr);
+            runPolicy(procMgr, FIFO_POLICY(isPerCpu));
             break;
         case LIFO:
-            doLIFO(procMgr, frameStr);
+            runPolicy(procMgr, LIFO_POLICY(isPerCpu));
             break;
         case RR:
-            doRR(procMgr, frameStr);
+            runPolicy(procMgr, RR_POLICY(isPerCpu));
             break;
         case SJF:
-            doSJF(procMgr, frameStr);
+            runPolicy(procMgr, SJF_POLICY(isPerCpu));
             break;
         case LJF:
-            doLJF(procMgr, frameStr);
+            runPolicy(procMgr, LJF_POLICY(isPerCpu));
+            break;
+        case SRTF:
+            runPolicy(procMgr, SRTF_POLICY(isPerCpu));
+            break;
+        case MLFQ:
+            runPolicy(procMgr, MLFQ_POLICY(isPerCpu));
             break;
         default:
-            strcpy(frameStr, "EInvalid algorithm specified");
+            procMgr->errFlag = SPM_ERR_SETTINGS;
             break;
     }
+}
+
+// runs the configured algorithm to completion (selected once, so no per-event dispatch)
+void runAlgorithm(ProcessManager* procMgr) {
+
+    if (procMgr->runQueues != NULL)
+        runAlgorithmLoop(procMgr, 1);
+    else
+        runAlgorithmLoop(procMgr, 0);
+}
+
+// restores a checkpoint into a freshly parsed manager (global queue, unstarted processes sorted); returns 1 on failure
+// arrivals up to the checkpoint must be the ones of the run it was taken in, so they are dropped and its snapshot takes their place
+int restoreCheckpoint(ProcessManager* procMgr, Checkpoint* checkpoint) {
+
+    // drop processes the checkpoint had already admitted
+    while (procMgr->unstarted.head != NULL && procMgr->unstarted.head->process.startTime <= checkpoint->time)
+        removeProcessFront(&procMgr->unstarted);
+
+    // rebuild the running set and queue in order, indexing as the policies above do (so heap ties break the same way)
+    char indexesQueue = procMgr->alg == SJF || procMgr->alg == LJF || procMgr->alg == SRTF;
+    for (unsigned int i = 0; i < checkpoint->numActive + checkpoint->numQueued; i++) {
+        ProcessNode* procNode = allocProcessNode(&procMgr->pool);
+        if (procNode == NULL) return 1;
+        procNode->process = checkpoint->processes[i];
+        procMgr->engineStats.nodeMoves++;
+        if (i < checkpoint->numActive) {
+            addActiveProcess(&procMgr->active, procNode);
+            if (procMgr->alg == SRTF && pushProcessHeap(&procMgr->activeHeap, procNode, checkpoint->time + procNode->process.remainingTime))
+                return 1;
+            if (procMgr->alg == MLFQ) addRunningLevel(&procMgr->activeLevels, procNode->process.level);
+        } else {
+            linkProcessBack(&procMgr->queue, procNode);
+            if (indexesQueue && pushProcessHeap(&procMgr->queueHeap, procNode, procNode->process.remainingTime))
+                return 1;
+            if (procMgr->alg == MLFQ && pushProcessLevels(&procMgr->queueLevels, procNode))
+                return 1;
+        }
+    }
+
+    // restore clock and drop frames from the checkpoint on
+    procMgr->time = checkpoint->time;
+    procMgr->prevTime = checkpoint->prevTime;
+    procMgr->numDecisions = checkpoint->numDecisions;
+    if (procMgr->frameBuf != NULL) {
+        procMgr->frameBuf->size = checkpoint->frameSize;
+        procMgr->frameBuf->numFrames = checkpoint->numFrames;
+    }
+
+    // drop intervals opened after the checkpoint and reopen the ones that were running (they match the running set in order)
+    IntervalBuffer* intervals = procMgr->intervals;
+    if (intervals != NULL) {
+        intervals->numIntervals = checkpoint->numIntervals;
+        intervals->numQueuePoints = checkpoint->numQueuePoints;
+        resetFreeCpus(intervals);
+        unsigned int numReopened = 0;
+        for (unsigned int i = checkpoint->firstOpenInterval; i < checkpoint->numIntervals; i++) {
+            unsigned int* interval = intervals->data + INTERVAL_WORDS * i;
+            if (interval[3] <= checkpoint->time) continue;
+            if (numReopened == checkpoint->numActive) return 1;
+            ProcessNode* procNode = procMgr->active.nodes[numReopened++];
+            procNode->cpu = interval[0];
+            procNode->interval = i;
+            claimCpu(intervals, interval[0]);
+            interval[3] = INTERVAL_OPEN;
+        }
+        if (numReopened != checkpoint->numActive) return 1;
+    }
+    if (procMgr->checkpoints != NULL) procMgr->checkpoints->numEvents = 0;
+    return 0;
+}
+
+// continues a restored run to completion: its next event depends on the new arrivals, so it is found again before the frames are written
+void resumeAlgorithm(ProcessManager* procMgr) {
+
+    procMgr->nextTime = procMgr->alg == RR ? getNextEventTime(procMgr, procMgr->time, RR_POLICY(0)) :
+        procMgr->alg == MLFQ ? getNextEventTime(procMgr, procMgr->time, MLFQ_POLICY(0)) : getNextEventTime(procMgr, procMgr->time, FIFO_POLICY(0));
+    if (procMgr->intervals != NULL) recordIntervalEvent(procMgr);
+    addFramesUntil(procMgr, procMgr->time, procMgr->nextTime);
+    if (procMgr->errFlag || !hasPendingProcesses(procMgr)) return;
+    advanceClock(procMgr);
+    runAlgorithm(procMgr);
+}
+
+char* getFrames(char* str) {
+
+    // create new process manager from parsed data
+    ProcessManager* procMgr = parseManagerFromString(str);
+    if (procMgr == NULL) {
+        LOG_ERROR("ERROR: could not generate process manager\n");
+        setEngineError(SPM_ERR_INPUT);
+        return "ECould not generate process manager, likely due to memory allocation or internal parsing error";
+    }
+    LOG_INFO("PARSED INPUT\n");
+    LOG_INFO("numCpus: %d, alg: %d, rrTime: %d\n", procMgr->numCpus, procMgr->alg, procMgr->rrQuantum);
+
+    // sort unstarted processes by start time and loop through process nodes (only traced builds list them)
+    if (sortProcessList(&procMgr->unstarted)) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return "ECould not allocate process memory";
+    }
+#if SPM_LOG_LEVEL >= SPM_LOG_TRACE
+    ProcessNode* curNode = procMgr->unstarted.head;
+    while (curNode != NULL) {
+        LOG_TRACE("\tpid: %u, startTime: %u, duration: %u\n", curNode->process.pid, curNode->process.startTime, curNode->process.remainingTime);
+        curNode = curNode->next;
+    }
+#endif
+
+    // create string (grows as frames are added)
+    procMgr->frameStrCapacity = MAX_FRAME_STR_LEN(procMgr->numCpus) + 1;
+    procMgr->frameStr = malloc(sizeof(char) * procMgr->frameStrCapacity);
+    if (procMgr->frameStr == NULL) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return "ECould not allocate frame string";
+    }
+    procMgr->frameStr[0] = '\0';
+
+    // run algorithm
+    runAlgorithm(procMgr);
+    char* frameStr = procMgr->frameStr;
+
+    // memory failures mid-run leave the frame string incomplete
+    if (procMgr->errFlag && frameStr[0] != 'E')
+        strcpy(frameStr, "ECould not allocate process memory");
+    setEngineError(procMgr->errFlag);
 
     // free process manager
     freeProcessManager(procMgr);
@@ -349,10 +1076,229 @@ char* getFrames(char* str) {
     return frameStr;
 }
 
+// runs a parsed manager into a new frame buffer and frees the manager; returns null on failure
+static FrameBuffer* runFrameData(ProcessManager* procMgr) {
+
+    // sort unstarted processes by start time
+    if (sortProcessList(&procMgr->unstarted)) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // create frame buffer
+    FrameBuffer* frameBuf = createFrameBuffer(procMgr->numCpus);
+    if (frameBuf == NULL) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    procMgr->frameBuf = frameBuf;
+
+    // run algorithm (discard frames on failure)
+    runAlgorithm(procMgr);
+    setEngineError(procMgr->errFlag);
+    if (procMgr->errFlag) {
+        freeFrameBuffer(frameBuf);
+        frameBuf = NULL;
+    }
+
+    // free process manager
+    freeProcessManager(procMgr);
+
+    // return frames
+    return frameBuf;
+}
+
+// binary alternative to getFrames; returns null on failure (free with freeFrameData)
+FrameBuffer* getFrameData(char* str) {
+
+    // create new process manager from parsed data
+    ProcessManager* procMgr = parseManagerFromString(str);
+    if (procMgr == NULL) {
+        LOG_ERROR("ERROR: could not generate process manager\n");
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+    return runFrameData(procMgr);
+}
+
+// getFrameData for array input (see SimConfig); returns null on failure (see spmGetError)
+FrameBuffer* getFrameDataFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses) {
+
+    ProcessManager* procMgr = createManagerFromArray(config, processes, numProcesses);
+    if (procMgr == NULL) return NULL;
+    return runFrameData(procMgr);
+}
+
+// runs a parsed manager into a new interval buffer and frees the manager; returns null on failure
+static IntervalBuffer* runIntervalData(ProcessManager* procMgr) {
+
+    // sort unstarted processes by start time and create interval buffer
+    IntervalBuffer* intervals = NULL;
+    if (sortProcessList(&procMgr->unstarted) || (intervals = createIntervalBuffer(procMgr->numCpus)) == NULL) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    procMgr->intervals = intervals;
+
+    // run algorithm (discard intervals on failure; times past 32 bits cannot be written)
+    runAlgorithm(procMgr);
+    setEngineError(procMgr->errFlag);
+    if (procMgr->errFlag) {
+        freeIntervalBuffer(intervals);
+        intervals = NULL;
+    }
+
+    // free process manager
+    freeProcessManager(procMgr);
+
+    // return intervals
+    return intervals;
+}
+
+// run-length alternative to getFrameData (see intervalbuf.h); returns null on failure (free with freeIntervalData)
+IntervalBuffer* getIntervalData(char* str) {
+
+    // create new process manager from parsed data
+    ProcessManager* procMgr = parseManagerFromString(str);
+    if (procMgr == NULL) {
+        LOG_ERROR("ERROR: could not generate process manager\n");
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+    return runIntervalData(procMgr);
+}
+
+// getIntervalData for array input (see SimConfig); returns null on failure (see spmGetError)
+IntervalBuffer* getIntervalDataFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses) {
+
+    ProcessManager* procMgr = createManagerFromArray(config, processes, numProcesses);
+    if (procMgr == NULL) return NULL;
+    return runIntervalData(procMgr);
+}
+
+// getIntervalData for a generated workload (see procgen.h); returns null on failure (see spmGetError)
+IntervalBuffer* getGeneratedIntervalData(const SimConfig* config, const GenParams* params) {
+
+    ProcessManager* procMgr = createGeneratedManager(config, params);
+    if (procMgr == NULL) return NULL;
+    return runIntervalData(procMgr);
+}
+
+void freeIntervalData(IntervalBuffer* intervals) {
+
+    freeIntervalBuffer(intervals);
+}
+
+// runs a parsed manager for its metrics only and frees the manager; returns null on failure
+static SimMetrics* runMetrics(ProcessManager* procMgr) {
+
+    // sort unstarted processes by start time
+    if (sortProcessList(&procMgr->unstarted)) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // create statistics and result
+    SimMetrics* metrics = malloc(sizeof(SimMetrics));
+    procMgr->stats = createProcessStats();
+    if (metrics == NULL || procMgr->stats == NULL) {
+        free(metrics);
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // run algorithm and summarize
+    runAlgorithm(procMgr);
+    setEngineError(procMgr->errFlag);
+    if (procMgr->errFlag) {
+        free(metrics);
+        metrics = NULL;
+    } else
+        *metrics = summarizeProcessStats(procMgr->stats, procMgr->numCpus);
+
+    // free process manager
+    freeProcessManager(procMgr);
+
+    // return metrics
+    return metrics;
+}
+
+// metrics-only alternative to getFrames (no frames are written); returns null on failure (free with free)
+SimMetrics* getMetrics(char* str) {
+
+    // create new process manager from parsed data
+    ProcessManager* procMgr = parseManagerFromString(str);
+    if (procMgr == NULL) {
+        LOG_ERROR("ERROR: could not generate process manager\n");
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+    return runMetrics(procMgr);
+}
+
+// getMetrics for array input (see SimConfig); returns null on failure (see spmGetError)
+SimMetrics* getMetricsFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses) {
+
+    ProcessManager* procMgr = createManagerFromArray(config, processes, numProcesses);
+    if (procMgr == NULL) return NULL;
+    return runMetrics(procMgr);
+}
+
+// getMetrics for a generated workload (see procgen.h); returns null on failure (see spmGetError)
+SimMetrics* getGeneratedMetrics(const SimConfig* config, const GenParams* params) {
+
+    ProcessManager* procMgr = createGeneratedManager(config, params);
+    if (procMgr == NULL) return NULL;
+    return runMetrics(procMgr);
+}
+
+void freeFrameData(FrameBuffer* frameBuf) {
+
+    freeFrameBuffer(frameBuf);
+}
+
+// returns the engine statistics so far, adding up the allocations made by the node pool and heaps
+EngineStats collectEngineStats(ProcessManager* procMgr) {
+
+    EngineStats engineStats = procMgr->engineStats;
+    engineStats.allocations += procMgr->pool.numSlabs + procMgr->queueHeap.numGrows + procMgr->activeHeap.numGrows + procMgr->queueLevels.numGrows;
+    if (procMgr->runQueues != NULL)
+        for (unsigned int cpu = 0; cpu < procMgr->runQueues->numCpus; cpu++)
+            engineStats.allocations += procMgr->runQueues->heaps[cpu].numGrows + (procMgr->runQueues->levels != NULL ? procMgr->runQueues->levels[cpu].numGrows : 0);
+    return engineStats;
+}
+
+// returns the statistics of the last simulation finished on the calling thread (i.e. whose process manager was freed)
+EngineStats* spmGetStats() {
+
+    return &lastEngineStats;
+}
+
 void freeProcessManager(ProcessManager* procMgr) {
 
-    // free process lists
-    freeProcessList(procMgr->active);
-    freeProcessList(procMgr->queue);
-    freeProcessList(procMgr->unstarted);
-}
\ No newline at end of file
+    // keep statistics for spmGetStats
+    lastEngineStats = collectEngineStats(procMgr);
+
+    // free all process nodes at once (every process list allocates from the pool)
+    freeProcessPool(&procMgr->pool);
+
+    // free process heaps and levels
+    freeProcessHeap(procMgr->queueHeap);
+    freeProcessHeap(procMgr->activeHeap);
+    freeProcessLevels(procMgr->queueLevels);
+
+    // free running set and run queues
+    freeActiveSet(procMgr->active);
+    freeRunQueues(procMgr->runQueues);
+
+    // free statistics
+    freeProcessStats(procMgr->stats);
+
+    // free process manager itself
+    free(procMgr);
+}
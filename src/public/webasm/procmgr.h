@@ -1,17 +1,53 @@
 
+#ifndef PROCMGR_H
+#define PROCMGR_H
+
 #include "proclist.h"
+#include "procheap.h"
+#include "proclevels.h"
+#include "procpool.h"
+#include "procset.h"
+#include "procrunq.h"
+#include "proccheck.h"
+#include "framebuf.h"
+#include "intervalbuf.h"
+#include "procstats.h"
+#include "spmlimits.h"
+#include "spmlog.h"
+
+// forces inlining (used to specialize the event loop per policy at compile time)
+#define SPM_INLINE static inline __attribute__((always_inline))
+
+// text frame format: queue_size;pid,remaining_time;...pid,remaining_time;\n...\0
+// max characters per frame = [queue_size_length] + ([process_data_length] * [num_cpus]) + [newline]
+#define MAX_FRAME_STR_LEN(numCpus) (11 + 22 * (numCpus) + 1)
+
+// phase timers (compiled in only with SPM_PROFILE, as reading a clock per phase would cost more than most phases)
+#ifdef SPM_PROFILE
+double getEngineSeconds();
+#define START_PHASE(phase) double phase##Start = getEngineSeconds()
+#define END_PHASE(procMgr, phase) ((procMgr)->engineStats.phase##Seconds += getEngineSeconds() - phase##Start)
+#else
+#define START_PHASE(phase) ((void)0)
+#define END_PHASE(procMgr, phase) ((void)0)
+#endif
+
+// engine statistics (counters are always kept; phase times are 0 unless built with SPM_PROFILE)
+// all fields are doubles so JS can read the struct as a Float64Array (do not reorder)
+typedef struct EngineStats {
+
+    double allocations;   // allocator calls for nodes, indexes and frame output (node slabs, heap and frame growth)
+    double nodeMoves;     // process nodes admitted, dispatched, requeued or retired
+    double queueScans;    // linear searches (arrival indexing walks, running set lookups, idle CPU and steal victim searches)
+    double framesEmitted;
+    double events;        // scheduling events handled
 
-#define MAX_NUM_CPUS 16
-#define NUM_ALGS 5
-#define MAX_TIME_AND_PID 255
+    double arrivalSeconds;  // admitting arrivals
+    double tickSeconds;     // advancing running processes
+    double dispatchSeconds; // dispatching, preempting and finding the next event
+    double frameSeconds;    // writing frames
 
-// frame format: 255;255,255;255,255;...255,255,255;\n...\0
-// max characters per frame = [queue_size_length] + ([process_data_length] * [max_cpus]) + [newline] = 4 + (8 * 16) + 1
-// = 4 + (8 * 16) + 1 = 133
-// max characters per entire frame string = [frame_length] * [frame_capacity] = ((4 + (8 * 16)) + 1) * 256;
-// = (4 + (8 * 16) + 1) * 256 = 34048
-#define MAX_FRAME_STR_LEN 133
-#define MAX_FULL_FRAME_STR_LEN 34048
+} EngineStats;
 
 // define enum for algorithms
 enum Algorithms {
@@ -19,27 +55,114 @@ enum Algorithms {
     LIFO,
     RR,
     SJF,
-    LJF
+    LJF,
+    SRTF,
+    MLFQ  // multilevel feedback queue (see proclevels.h)
+};
+
+// algorithms that take a quantum (NUM_QUANTUM_ALGS of them; usesQuantum in algs.mjs mirrors this)
+#define USES_QUANTUM(alg) ((alg) == RR || (alg) == MLFQ)
+
+// engine settings for array input (all 32-bit words so JS can write the struct through HEAPU32; do not reorder)
+typedef struct SimConfig {
+
+    unsigned int numCpus;
+    unsigned int alg;
+    unsigned int rrQuantum;
+
+} SimConfig;
+
+// engine errors (spmGetError returns the one of the last call on the calling thread)
+enum SpmErrors {
+    SPM_OK,
+    SPM_ERR_INPUT,     // missing or malformed input
+    SPM_ERR_SETTINGS,  // CPU count, algorithm or generator parameters out of range
+    SPM_ERR_PROCESSES, // more than MAX_PROCESSES processes
+    SPM_ERR_MEMORY,    // allocation failed (while setting up or running)
+    SPM_ERR_LIMIT      // output over MAX_FRAME_DATA_BYTES, or simulated time past what 32-bit output can hold
 };
 
+// arrival source: appends processes in start time order to 'unstarted' until one starts after 'time' or none are left
+// returns 0 while more may follow, 1 once every process was read, -1 on failure
+typedef int (*ReadArrivals)(void* arrivalSource, struct ProcessList* unstarted, unsigned long long time);
+
 // process manager
 typedef struct ProcessManager {
 
     // static configuration
     unsigned int numCpus;
     enum Algorithms alg;
-    unsigned int rrQuantum; // only non-zero for round robin
+    unsigned int rrQuantum; // only non-zero for round robin and MLFQ (its top level quantum)
+
+    // node allocator (owns every process node below)
+    struct ProcessPool pool;
 
     // dynamic states
-    struct ProcessList active;    // currently running processes
+    struct ActiveSet active;      // currently running processes
     struct ProcessList queue;     // processes 'started' but not active
     struct ProcessList unstarted; // processes not yet started
 
-    char errFlag; // 0 if good, 1 if bad
+    // streamed arrivals (null once read or if every process was added up front; global queue or per-CPU, no checkpoints)
+    ReadArrivals readArrivals;
+    void* arrivalSource;
+
+    // indexes (only used by selection algorithms)
+    struct ProcessHeap queueHeap;  // queued processes by remaining time (min for SJF / SRTF, max for LJF)
+    struct ProcessHeap activeHeap; // active processes by completion time (max, for SRTF preemption)
+    struct ProcessLevels queueLevels;  // queued processes by feedback level (MLFQ)
+    struct RunningLevels activeLevels; // active processes' feedback levels (MLFQ preemption)
+
+    // per-CPU run queues with work stealing (null uses the global queue above)
+    struct RunQueues* runQueues;
+
+    // frame output (any may be null)
+    char* frameStr;               // text frames
+    unsigned int frameStrLen;
+    unsigned int frameStrCapacity;
+    struct FrameBuffer* frameBuf; // binary frames
+    struct IntervalBuffer* intervals; // execution intervals and queue length changes (the frames in run-length form)
+
+    // snapshots taken every few events so a later run can resume (null unless requested; global queue only; not owned)
+    struct CheckpointList* checkpoints;
+
+    // clock and counters
+    unsigned long long time;         // simulated time of the current event (end time once finished)
+    unsigned long long prevTime;     // time of the previous event
+    unsigned long long nextTime;     // time of the next event (once the current one is handled)
+    unsigned long long numDecisions; // number of processes dispatched to a CPU
+    struct ProcessStats* stats;      // scheduling statistics (null unless requested)
+    struct EngineStats engineStats;  // engine counters (allocations are added up when the manager is freed)
+
+    char errFlag; // SPM_OK if good, otherwise the engine error (enum SpmErrors) that stopped the run
     
 } ProcessManager;
 
-ProcessManager* createProcessManager(unsigned int numCpus, enum Algorithms alg, unsigned int rrQuantum, ProcessList processes);
+ProcessManager* createProcessManager(unsigned int numCpus, enum Algorithms alg, unsigned int rrQuantum);
 ProcessManager* parseManagerFromString(char* str);
+ProcessManager* createManagerFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses);
+void setEngineError(enum SpmErrors error);
+int spmGetError();
+int usePerCpuQueues(ProcessManager* procMgr);
+int useArrivalSource(ProcessManager* procMgr, ReadArrivals readArrivals, void* arrivalSource);
+unsigned int getQueueSize(ProcessManager* procMgr);
+void writeFrameData(ProcessManager* procMgr, unsigned int* frame, unsigned int elapsed);
+int hasPendingProcesses(ProcessManager* procMgr);
+void runEvent(ProcessManager* procMgr);
+void advanceClock(ProcessManager* procMgr);
+void runAlgorithm(ProcessManager* procMgr);
+int restoreCheckpoint(ProcessManager* procMgr, Checkpoint* checkpoint);
+void resumeAlgorithm(ProcessManager* procMgr);
 char* getFrames(char* str);
-void freeProcessManager(ProcessManager* procMan);
\ No newline at end of file
+FrameBuffer* getFrameData(char* str);
+FrameBuffer* getFrameDataFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses);
+void freeFrameData(FrameBuffer* frameBuf);
+IntervalBuffer* getIntervalData(char* str);
+IntervalBuffer* getIntervalDataFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses);
+void freeIntervalData(IntervalBuffer* intervals);
+SimMetrics* getMetrics(char* str);
+SimMetrics* getMetricsFromArray(const SimConfig* config, const unsigned int* processes, unsigned int numProcesses);
+EngineStats collectEngineStats(ProcessManager* procMgr);
+EngineStats* spmGetStats();
+void freeProcessManager(ProcessManager* procMan);
+
+#endif
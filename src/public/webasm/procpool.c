@@ -0,0 +1,57 @@
+#include "procpool.h"
+#include <stdlib.h>
+
+// create process pool
+ProcessPool createProcessPool() {
+
+    return (ProcessPool){ .slabs = NULL, .freeNodes = NULL, .numSlabs = 0 };
+}
+
+// returns null on allocation failure
+ProcessNode* allocProcessNode(ProcessPool* procPool) {
+
+    // reuse released node if any
+    if (procPool->freeNodes != NULL) {
+        ProcessNode* procNode = procPool->freeNodes;
+        procPool->freeNodes = procNode->next;
+        return procNode;
+    }
+
+    // add new slab if current one is full (slabs grow geometrically up to a limit)
+    ProcessSlab* slab = procPool->slabs;
+    if (slab == NULL || slab->used == slab->capacity) {
+        unsigned int capacity = slab == NULL ? MIN_SLAB_NODES : slab->capacity * 2;
+        if (capacity > MAX_SLAB_NODES) capacity = MAX_SLAB_NODES;
+        slab = malloc(sizeof(ProcessSlab) + sizeof(ProcessNode) * capacity);
+        if (slab == NULL) return NULL;
+        slab->next = procPool->slabs;
+        slab->capacity = capacity;
+        slab->used = 0;
+        procPool->slabs = slab;
+        procPool->numSlabs++;
+    }
+
+    // carve node from slab
+    return &slab->nodes[slab->used++];
+}
+
+void releaseProcessNode(ProcessPool* procPool, ProcessNode* procNode) {
+
+    // push onto free list
+    procNode->next = procPool->freeNodes;
+    procPool->freeNodes = procNode;
+}
+
+void freeProcessPool(ProcessPool* procPool) {
+
+    // free slabs
+    ProcessSlab* slab = procPool->slabs;
+    while (slab != NULL) {
+        ProcessSlab* tmpSlab = slab;
+        slab = slab->next;
+        free(tmpSlab);
+    }
+
+    // reset
+    *procPool = createProcessPool();
+}
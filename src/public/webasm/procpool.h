@@ -0,0 +1,38 @@
+// This header file represents a slab allocator for process nodes.
+// Nodes are carved out of large slabs and recycled through a free list, so moving processes between lists never touches malloc.
+
+#ifndef PROCPOOL_H
+#define PROCPOOL_H
+
+#include "proclist.h"
+
+#define MIN_SLAB_NODES 64
+#define MAX_SLAB_NODES 65536
+
+// slab of process nodes
+typedef struct ProcessSlab {
+
+    struct ProcessSlab* next;
+    unsigned int capacity;
+    unsigned int used;
+    struct ProcessNode nodes[];
+
+} ProcessSlab;
+
+// process pool
+typedef struct ProcessPool {
+
+    struct ProcessSlab* slabs;     // most recent slab first
+    struct ProcessNode* freeNodes; // released nodes (linked through next)
+    unsigned int numSlabs;         // slabs allocated so far (engine statistics)
+
+} ProcessPool;
+
+ProcessPool createProcessPool();
+
+ProcessNode* allocProcessNode(ProcessPool* procPool);
+void releaseProcessNode(ProcessPool* procPool, ProcessNode* procNode);
+
+void freeProcessPool(ProcessPool* procPool); // frees every node ever allocated from the pool
+
+#endif
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include "procresim.h"
+#include <stdlib.h>
+#include <limits.h>
+
+// returns null on failure (free with spmSessionDestroy)
+ResimSession* spmSessionCreate() {
+
+    // init new session (no run yet)
+    ResimSession* session = malloc(sizeof(ResimSession));
+    if (session == NULL) return NULL;
+    *session = (ResimSession){ 0 };
+    session->checkpoints = createCheckpointList();
+    if (session->checkpoints == NULL) {
+        free(session);
+        return NULL;
+    }
+    return session;
+}
+
+// forgets the last run's intervals and checkpoints (the next run starts from scratch)
+static void resetSessionOutput(ResimSession* session) {
+
+    freeIntervalBuffer(session->intervals);
+    session->intervals = NULL;
+    truncateCheckpoints(session->checkpoints, 0);
+    session->checkpoints->interval = MIN_CHECKPOINT_INTERVAL;
+}
+
+// copies sorted processes (the input the next run is compared against); returns null on allocation failure
+static Process* copyProcesses(ProcessList* procList) {
+
+    Process* processes = malloc(sizeof(Process) * (procList->size + 1));
+    if (processes == NULL) return NULL;
+    unsigned int i = 0;
+    for (ProcessNode* curNode = procList->head; curNode != NULL; curNode = curNode->next)
+        processes[i++] = curNode->process;
+    return processes;
+}
+
+// returns the earliest start time two inputs (in start time order) differ at; ULLONG_MAX if they are the same
+// both are sorted the same stable way, so they agree up to the first differing entry, and every later entry starts no earlier
+static unsigned long long findFirstChange(Process* processesA, unsigned int numA, Process* processesB, unsigned int numB) {
+
+    unsigned int i = 0;
+    while (i < numA && i < numB && processesA[i].pid == processesB[i].pid &&
+        processesA[i].startTime == processesB[i].startTime && processesA[i].duration == processesB[i].duration)
+        i++;
+
+    if (i == numA && i == numB) return ULLONG_MAX;
+    if (i == numA) return processesB[i].startTime;
+    if (i == numB) return processesA[i].startTime;
+    return processesA[i].startTime < processesB[i].startTime ? processesA[i].startTime : processesB[i].startTime;
+}
+
+// runs a parsed manager in the session and frees the manager (see spmSessionRun)
+static IntervalBuffer* runSessionManager(ResimSession* session, ProcessManager* procMgr) {
+
+    // sort unstarted processes by start time
+    Process* processes = NULL;
+    if (sortProcessList(&procMgr->unstarted) || (processes = copyProcesses(&procMgr->unstarted)) == NULL) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // earliest start time the input changed at (other settings change every frame)
+    unsigned long long changeTime = 0;
+    if (session->processes != NULL && session->intervals != NULL && procMgr->numCpus == session->numCpus &&
+        procMgr->alg == session->alg && procMgr->rrQuantum == session->rrQuantum)
+        changeTime = findFirstChange(session->processes, session->numProcesses, processes, procMgr->unstarted.size);
+
+    // keep this input for the next run
+    free(session->processes);
+    session->processes = processes;
+    session->numProcesses = procMgr->unstarted.size;
+    session->numCpus = procMgr->numCpus;
+    session->alg = procMgr->alg;
+    session->rrQuantum = procMgr->rrQuantum;
+
+    // unchanged input: the last run's intervals are still the result
+    if (changeTime == ULLONG_MAX) {
+        session->numReusedFrames = session->intervals->numFrames;
+        freeProcessManager(procMgr);
+        setEngineError(SPM_OK);
+        return session->intervals;
+    }
+
+    // resume from the last checkpoint before the change (nothing before it can differ), or start over without one
+    unsigned int checkpoint = findCheckpoint(session->checkpoints, changeTime);
+    char isResumed = checkpoint < session->checkpoints->size;
+    if (!isResumed)
+        resetSessionOutput(session);
+    else
+        truncateCheckpoints(session->checkpoints, checkpoint + 1);
+
+    // intervals are written into the session's buffer (kept across runs) and checkpoints into its list
+    if (session->intervals == NULL && (session->intervals = createIntervalBuffer(procMgr->numCpus)) == NULL) {
+        freeProcessManager(procMgr);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    procMgr->intervals = session->intervals;
+    procMgr->checkpoints = session->checkpoints;
+
+    // run algorithm
+    session->numReusedFrames = 0;
+    if (!isResumed)
+        runAlgorithm(procMgr);
+    else if (restoreCheckpoint(procMgr, &session->checkpoints->checkpoints[checkpoint]))
+        procMgr->errFlag = SPM_ERR_MEMORY;
+    else {
+        session->numReusedFrames = session->checkpoints->checkpoints[checkpoint].time;
+        resumeAlgorithm(procMgr);
+    }
+
+    // a failed run leaves nothing to resume from
+    IntervalBuffer* intervals = session->intervals;
+    setEngineError(procMgr->errFlag);
+    if (procMgr->errFlag) {
+        resetSessionOutput(session);
+        intervals = NULL;
+    }
+    freeProcessManager(procMgr);
+    return intervals;
+}
+
+IntervalBuffer* spmSessionRun(ResimSession* session, char* str) {
+
+    // create process manager from parsed data
+    ProcessManager* procMgr = parseManagerFromString(str);
+    if (procMgr == NULL) {
+        LOG_ERROR("ERROR: could not generate process manager\n");
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+    return runSessionManager(session, procMgr);
+}
+
+IntervalBuffer* spmSessionRunArray(ResimSession* session, const SimConfig* config, const unsigned int* processes, unsigned int numProcesses) {
+
+    // create process manager from settings and packed processes (no parsing)
+    ProcessManager* procMgr = createManagerFromArray(config, processes, numProcesses);
+    if (procMgr == NULL) return NULL;
+    return runSessionManager(session, procMgr);
+}
+
+void spmSessionDestroy(ResimSession* session) {
+
+    // free last run and session itself
+    if (session == NULL) return;
+    free(session->processes);
+    freeIntervalBuffer(session->intervals);
+    freeCheckpointList(session->checkpoints);
+    free(session);
+}
@@ -0,0 +1,29 @@
+// This header file represents a re-simulation session: interval runs (see intervalbuf.h) of successive edits of one workload.
+// Each run is checkpointed; the next run reuses every interval before the earliest start time its input changed and resumes from the last checkpoint before it.
+
+#ifndef PROCRESIM_H
+#define PROCRESIM_H
+
+#include "procmgr.h"
+
+// session (settings, input and output of the last run)
+typedef struct ResimSession {
+
+    unsigned int numCpus;
+    enum Algorithms alg;
+    unsigned int rrQuantum;
+    struct Process* processes;   // input of the last run in start time order (null before the first run)
+    unsigned int numProcesses;
+
+    struct IntervalBuffer* intervals;   // intervals of the last run
+    struct CheckpointList* checkpoints; // checkpoints of the last run
+    unsigned int numReusedFrames;       // frames the last run kept from the one before
+
+} ResimSession;
+
+ResimSession* spmSessionCreate();
+IntervalBuffer* spmSessionRun(ResimSession* session, char* str); // same input format as getFrames; intervals stay valid until the next run (null on failure)
+IntervalBuffer* spmSessionRunArray(ResimSession* session, const SimConfig* config, const unsigned int* processes, unsigned int numProcesses); // packed (pid, start, duration) triples
+void spmSessionDestroy(ResimSession* session);
+
+#endif
@@ -0,0 +1,86 @@
+#include "procring.h"
+#include "spmlimits.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// JS reads the indexes by these offsets
+_Static_assert(offsetof(ProcessRing, head) == 4 * RING_HEAD_WORD, "ring head offset");
+_Static_assert(offsetof(ProcessRing, tail) == 4 * RING_TAIL_WORD, "ring tail offset");
+
+// the slot size cannot wrap, even where size_t is 32 bits (WASM)
+_Static_assert(MAX_RING_CAPACITY <= 0xFFFFFFFFu / (RING_ENTRY_WORDS * sizeof(unsigned int)), "ring capacity too large");
+
+// returns null on allocation failure (or a capacity over MAX_RING_CAPACITY)
+ProcessRing* createProcessRing(unsigned int capacity) {
+
+    // round capacity up to a power of two (indexes wrap with a mask)
+    if (capacity == 0 || capacity > MAX_RING_CAPACITY) return NULL;
+    unsigned int roundedCapacity = 1;
+    while (roundedCapacity < capacity) roundedCapacity <<= 1;
+
+    // init new empty ring (aligned so the indexes really sit on separate cache lines)
+    ProcessRing* ring = aligned_alloc(64, sizeof(ProcessRing));
+    if (ring == NULL) return NULL;
+    ring->slots = malloc(sizeof(unsigned int) * RING_ENTRY_WORDS * roundedCapacity);
+    if (ring->slots == NULL) {
+        free(ring);
+        return NULL;
+    }
+    ring->mask = roundedCapacity - 1;
+    atomic_init(&ring->closed, 0);
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return ring;
+}
+
+int pushProcess(ProcessRing* ring, unsigned int pid, unsigned int startTime, unsigned int duration) {
+
+    // full if the consumer has not freed the slot one lap back
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&ring->head, memory_order_acquire) > ring->mask) return 1;
+
+    // write entry, then publish it
+    unsigned int* entry = ring->slots + RING_ENTRY_WORDS * (tail & ring->mask);
+    entry[0] = pid;
+    entry[1] = startTime;
+    entry[2] = duration;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+void closeProcessRing(ProcessRing* ring) {
+
+    atomic_store_explicit(&ring->closed, 1, memory_order_release);
+}
+
+unsigned int popProcesses(ProcessRing* ring, unsigned int* entries, unsigned int maxCount) {
+
+    // entries published so far
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned int count = atomic_load_explicit(&ring->tail, memory_order_acquire) - head;
+    if (count > maxCount) count = maxCount;
+
+    // copy them (in up to two runs, since they may wrap), then free their slots
+    unsigned int first = head & ring->mask;
+    unsigned int firstRun = ring->mask + 1 - first;
+    if (firstRun > count) firstRun = count;
+    memcpy(entries, ring->slots + RING_ENTRY_WORDS * first, sizeof(unsigned int) * RING_ENTRY_WORDS * firstRun);
+    memcpy(entries + RING_ENTRY_WORDS * firstRun, ring->slots, sizeof(unsigned int) * RING_ENTRY_WORDS * (count - firstRun));
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+    return count;
+}
+
+int isProcessRingClosed(ProcessRing* ring) {
+
+    // 'closed' is read first: once it is set, the tail holds every entry the producer will write
+    if (!atomic_load_explicit(&ring->closed, memory_order_acquire)) return 0;
+    return atomic_load_explicit(&ring->tail, memory_order_acquire) == atomic_load_explicit(&ring->head, memory_order_relaxed);
+}
+
+void freeProcessRing(ProcessRing* ring) {
+
+    if (ring == NULL) return;
+    free(ring->slots);
+    free(ring);
+}
@@ -0,0 +1,41 @@
+// This header file represents a single-producer / single-consumer ring of process submissions for live simulations.
+// The producer (another thread, or JS writing shared WASM memory) only writes the slots, 'tail' and 'closed'; the consumer (the stepping thread) only writes 'head'.
+// Neither side locks: an index is published with a release store after the slots it covers, and read with an acquire load.
+
+#ifndef PROCRING_H
+#define PROCRING_H
+
+#include <stdatomic.h>
+
+// entry format: [pid] [start_time] [duration]
+#define RING_ENTRY_WORDS 3
+
+// 32-bit word offsets of the indexes (each on its own cache line, so producer and consumer do not share one)
+#define RING_HEAD_WORD 16
+#define RING_TAIL_WORD 32
+
+typedef struct ProcessRing {
+
+    // header (field order is read by index from JS; do not reorder)
+    unsigned int* slots;  // capacity entries
+    unsigned int mask;    // capacity - 1 (capacity is a power of two)
+    atomic_uint closed;   // set by the producer after its last entry
+
+    _Alignas(64) atomic_uint head; // entries consumed (free-running; the slot is head & mask)
+    _Alignas(64) atomic_uint tail; // entries published
+
+} ProcessRing;
+
+ProcessRing* createProcessRing(unsigned int capacity); // rounded up to a power of two; null if 0 or over MAX_RING_CAPACITY
+
+// producer side
+int pushProcess(ProcessRing* ring, unsigned int pid, unsigned int startTime, unsigned int duration); // returns 1 if the ring is full
+void closeProcessRing(ProcessRing* ring);
+
+// consumer side
+unsigned int popProcesses(ProcessRing* ring, unsigned int* entries, unsigned int maxCount); // copies up to maxCount entries; returns the number copied
+int isProcessRingClosed(ProcessRing* ring); // closed and fully consumed
+
+void freeProcessRing(ProcessRing* ring);
+
+#endif
@@ -0,0 +1,137 @@
+#include "procrunq.h"
+#include <stdlib.h>
+
+// create run queues for 'numCpus' CPUs (all idle, nothing waiting); returns null on failure
+RunQueues* createRunQueues(unsigned int numCpus, char isMaxHeap, char hasLevels, struct ProcessPool* procPool) {
+
+    // allocate run queues and their arrays
+    unsigned int numWords = (numCpus + CPU_MASK_BITS - 1) / CPU_MASK_BITS;
+    RunQueues* runQueues = malloc(sizeof(RunQueues));
+    if (runQueues == NULL) return NULL;
+    runQueues->queues = malloc(sizeof(ProcessList) * numCpus);
+    runQueues->heaps = malloc(sizeof(ProcessHeap) * numCpus);
+    runQueues->levels = hasLevels ? malloc(sizeof(ProcessLevels) * numCpus) : NULL;
+    runQueues->running = calloc(numCpus, sizeof(ProcessNode*));
+    runQueues->completionTime = calloc(numCpus, sizeof(unsigned long long));
+    runQueues->idleMask = calloc(numWords, sizeof(unsigned long long));
+    runQueues->queuedMask = calloc(numWords, sizeof(unsigned long long));
+    if (runQueues->queues == NULL || runQueues->heaps == NULL || (hasLevels && runQueues->levels == NULL) || runQueues->running == NULL ||
+        runQueues->completionTime == NULL || runQueues->idleMask == NULL || runQueues->queuedMask == NULL) {
+        runQueues->numCpus = 0;
+        freeRunQueues(runQueues);
+        return NULL;
+    }
+
+    // init empty queues (nodes come from the manager's pool) and mark every CPU idle
+    for (unsigned int cpu = 0; cpu < numCpus; cpu++) {
+        runQueues->queues[cpu] = createProcessList(procPool);
+        runQueues->heaps[cpu] = createProcessHeap(isMaxHeap);
+        if (hasLevels) runQueues->levels[cpu] = createProcessLevels();
+        runQueues->idleMask[cpu / CPU_MASK_BITS] |= 1ull << (cpu % CPU_MASK_BITS);
+    }
+
+    runQueues->numCpus = numCpus;
+    runQueues->numWords = numWords;
+    runQueues->numQueued = 0;
+    runQueues->nextCpu = 0;
+    runQueues->numSteals = 0;
+    return runQueues;
+}
+
+// appends a process to a CPU's run queue (and its heap if the algorithm selects by remaining time, or its levels if by feedback level)
+int addRunQueueProcess(RunQueues* runQueues, unsigned int cpu, ProcessNode* procNode, char isIndexed, char isLeveled) {
+
+    procNode->cpu = cpu;
+    linkProcessBack(&runQueues->queues[cpu], procNode);
+    runQueues->queuedMask[cpu / CPU_MASK_BITS] |= 1ull << (cpu % CPU_MASK_BITS);
+    runQueues->numQueued++;
+    if (isLeveled) return pushProcessLevels(&runQueues->levels[cpu], procNode);
+    return isIndexed && pushProcessHeap(&runQueues->heaps[cpu], procNode, procNode->process.remainingTime);
+}
+
+// takes a process off the run queue it waits in
+void removeRunQueueProcess(RunQueues* runQueues, ProcessNode* procNode) {
+
+    unsigned int cpu = procNode->cpu;
+    unlinkProcess(&runQueues->queues[cpu], procNode);
+    if (runQueues->queues[cpu].head == NULL)
+        runQueues->queuedMask[cpu / CPU_MASK_BITS] &= ~(1ull << (cpu % CPU_MASK_BITS));
+    runQueues->numQueued--;
+}
+
+// records the process a CPU runs (null marks it idle)
+void setCpuProcess(RunQueues* runQueues, unsigned int cpu, ProcessNode* procNode) {
+
+    runQueues->running[cpu] = procNode;
+    if (procNode == NULL)
+        runQueues->idleMask[cpu / CPU_MASK_BITS] |= 1ull << (cpu % CPU_MASK_BITS);
+    else {
+        procNode->cpu = cpu;
+        runQueues->idleMask[cpu / CPU_MASK_BITS] &= ~(1ull << (cpu % CPU_MASK_BITS));
+    }
+}
+
+// returns the lowest CPU from 'first' on whose bit is set (one word at a time)
+unsigned int findNextCpu(unsigned long long* mask, unsigned int numCpus, unsigned int first) {
+
+    if (first >= numCpus) return numCpus;
+
+    // mask off bits below first in its word, then skip empty words
+    unsigned int word = first / CPU_MASK_BITS;
+    unsigned long long bits = mask[word] & (~0ull << (first % CPU_MASK_BITS));
+    unsigned int numWords = (numCpus + CPU_MASK_BITS - 1) / CPU_MASK_BITS;
+    while (bits == 0) {
+        if (++word == numWords) return numCpus;
+        bits = mask[word];
+    }
+
+    unsigned int cpu = word * CPU_MASK_BITS + __builtin_ctzll(bits);
+    return cpu < numCpus ? cpu : numCpus;
+}
+
+// returns the lowest CPU from 'first' on that is idle and has waiting processes
+unsigned int findNextReadyCpu(RunQueues* runQueues, unsigned int first) {
+
+    if (first >= runQueues->numCpus) return runQueues->numCpus;
+
+    // same scan as findNextCpu, over the intersection of both bitmaps
+    unsigned int word = first / CPU_MASK_BITS;
+    unsigned long long bits = runQueues->idleMask[word] & runQueues->queuedMask[word] & (~0ull << (first % CPU_MASK_BITS));
+    while (bits == 0) {
+        if (++word == runQueues->numWords) return runQueues->numCpus;
+        bits = runQueues->idleMask[word] & runQueues->queuedMask[word];
+    }
+
+    unsigned int cpu = word * CPU_MASK_BITS + __builtin_ctzll(bits);
+    return cpu < runQueues->numCpus ? cpu : runQueues->numCpus;
+}
+
+// returns the CPU an idle 'cpu' steals from: the next one after it (wrapping around) with waiting processes
+// always the same choice for the same state, so runs stay reproducible
+unsigned int findStealVictim(RunQueues* runQueues, unsigned int cpu) {
+
+    unsigned int victim = findNextCpu(runQueues->queuedMask, runQueues->numCpus, cpu + 1);
+    if (victim == runQueues->numCpus)
+        victim = findNextCpu(runQueues->queuedMask, runQueues->numCpus, 0);
+    return victim;
+}
+
+void freeRunQueues(RunQueues* runQueues) {
+
+    if (runQueues == NULL) return;
+
+    // free heaps and levels (queue nodes belong to the manager's pool)
+    for (unsigned int cpu = 0; cpu < runQueues->numCpus; cpu++) {
+        freeProcessHeap(runQueues->heaps[cpu]);
+        if (runQueues->levels != NULL) freeProcessLevels(runQueues->levels[cpu]);
+    }
+
+    free(runQueues->queues);
+    free(runQueues->heaps);
+    free(runQueues->levels);
+    free(runQueues->running);
+    free(runQueues->completionTime);
+    free(runQueues->idleMask);
+    free(runQueues->queuedMask);
+    free(runQueues);
+}
@@ -0,0 +1,45 @@
+// This header file represents per-CPU run queues, an alternative to the process manager's single global queue.
+// Arrivals are spread over the CPUs, each CPU runs from its own queue and idle CPUs steal from busy ones, so large machines are not served by one list.
+
+#ifndef PROCRUNQ_H
+#define PROCRUNQ_H
+
+#include "proclist.h"
+#include "procheap.h"
+#include "proclevels.h"
+
+// bits per bitmap word
+#define CPU_MASK_BITS 64
+
+// run queues (one per CPU) with bitmaps of idle CPUs and CPUs with waiting processes
+typedef struct RunQueues {
+
+    struct ProcessList* queues;          // waiting processes per CPU
+    struct ProcessHeap* heaps;           // waiting processes per CPU by remaining time (only used by selection algorithms)
+    struct ProcessLevels* levels;        // waiting processes per CPU by feedback level (MLFQ only; null otherwise)
+    struct ProcessNode** running;        // process on each CPU (null while idle)
+    unsigned long long* completionTime;  // completion time of the process on each CPU (only used for SRTF preemption)
+    unsigned long long* idleMask;        // bit per CPU, set while it runs nothing
+    unsigned long long* queuedMask;      // bit per CPU, set while its run queue is not empty
+
+    unsigned int numCpus;
+    unsigned int numWords;  // words per bitmap
+    unsigned int numQueued; // waiting processes over all run queues
+    unsigned int nextCpu;   // CPU the next arrival is placed on (arrivals are dealt out in turn)
+    unsigned long long numSteals; // processes an idle CPU took from another CPU's queue
+
+} RunQueues;
+
+RunQueues* createRunQueues(unsigned int numCpus, char isMaxHeap, char hasLevels, struct ProcessPool* procPool);
+
+int addRunQueueProcess(RunQueues* runQueues, unsigned int cpu, ProcessNode* procNode, char isIndexed, char isLeveled); // returns 1 if it could not be indexed
+void removeRunQueueProcess(RunQueues* runQueues, ProcessNode* procNode); // unlinks only; heaps are popped by the caller
+void setCpuProcess(RunQueues* runQueues, unsigned int cpu, ProcessNode* procNode); // null marks the CPU idle
+
+unsigned int findNextCpu(unsigned long long* mask, unsigned int numCpus, unsigned int first); // returns numCpus if no bit is set from first on
+unsigned int findNextReadyCpu(RunQueues* runQueues, unsigned int first); // idle with waiting processes; returns numCpus if none
+unsigned int findStealVictim(RunQueues* runQueues, unsigned int cpu); // returns numCpus if nothing is waiting
+
+void freeRunQueues(RunQueues* runQueues);
+
+#endif
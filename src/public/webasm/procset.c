@@ -0,0 +1,231 @@
+#include "procset.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// pick the widest vector unit the build targets (the scalar loop handles the remainder and builds without one)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ACTIVE_SET_LANES 8
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define ACTIVE_SET_LANES 4
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define ACTIVE_SET_LANES 4
+#else
+#define ACTIVE_SET_LANES 1
+#endif
+
+// create active set for up to 'capacity' processes (one allocation for all arrays)
+ActiveSet createActiveSet(unsigned int capacity) {
+
+    ActiveSet activeSet = { .nodes = NULL, .pid = NULL, .remainingTime = NULL, .rrTime = NULL, .size = 0, .capacity = capacity };
+    activeSet.nodes = malloc((sizeof(ProcessNode*) + 3 * sizeof(unsigned int)) * capacity);
+    if (activeSet.nodes == NULL) return activeSet;
+
+    // carve arrays
+    activeSet.pid = (unsigned int*)(activeSet.nodes + capacity);
+    activeSet.remainingTime = activeSet.pid + capacity;
+    activeSet.rrTime = activeSet.remainingTime + capacity;
+    return activeSet;
+}
+
+// appends a process (the caller never exceeds capacity, as there is one slot per CPU)
+void addActiveProcess(ActiveSet* activeSet, ProcessNode* procNode) {
+
+    unsigned int index = activeSet->size++;
+    activeSet->nodes[index] = procNode;
+    activeSet->pid[index] = procNode->process.pid;
+    activeSet->remainingTime[index] = procNode->process.remainingTime;
+    activeSet->rrTime[index] = procNode->process.rrTime;
+}
+
+// removes the process at index, keeping the order of the rest; returns its node
+ProcessNode* removeActiveProcess(ActiveSet* activeSet, unsigned int index) {
+
+    // write times back to the node
+    ProcessNode* procNode = activeSet->nodes[index];
+    procNode->process.remainingTime = activeSet->remainingTime[index];
+    procNode->process.rrTime = activeSet->rrTime[index];
+
+    // clear and close the gap
+    activeSet->nodes[index] = NULL;
+    compactActiveSet(activeSet, index);
+    return procNode;
+}
+
+unsigned int findActiveProcess(ActiveSet* activeSet, ProcessNode* procNode) {
+
+    unsigned int index = 0;
+    while (index < activeSet->size && activeSet->nodes[index] != procNode)
+        index++;
+    return index;
+}
+
+// drops processes whose node was cleared (from index 'first' on), moving each run of kept processes down at once so their order is kept
+void compactActiveSet(ActiveSet* activeSet, unsigned int first) {
+
+    unsigned int size = activeSet->size;
+    unsigned int destIndex = first;
+    unsigned int i = first;
+    while (i < size) {
+
+        // skip cleared processes
+        if (activeSet->nodes[i] == NULL) {
+            i++;
+            continue;
+        }
+
+        // find run of kept processes and move it (array by array)
+        unsigned int runStart = i;
+        while (i < size && activeSet->nodes[i] != NULL)
+            i++;
+        unsigned int runLength = i - runStart;
+        if (destIndex != runStart) {
+            memmove(activeSet->nodes + destIndex, activeSet->nodes + runStart, sizeof(ProcessNode*) * runLength);
+            memmove(activeSet->pid + destIndex, activeSet->pid + runStart, sizeof(unsigned int) * runLength);
+            memmove(activeSet->remainingTime + destIndex, activeSet->remainingTime + runStart, sizeof(unsigned int) * runLength);
+            memmove(activeSet->rrTime + destIndex, activeSet->rrTime + runStart, sizeof(unsigned int) * runLength);
+        }
+        destIndex += runLength;
+    }
+    activeSet->size = destIndex;
+}
+
+// runs every process for 'elapsed' seconds (and adds it to the round robin time if isRR)
+// returns the index of the first process that finished or used up its quantum (size if none did)
+unsigned int tickActiveSet(ActiveSet* activeSet, unsigned int elapsed, unsigned int rrQuantum, char isRR) {
+
+    unsigned int* remainingTime = activeSet->remainingTime;
+    unsigned int* rrTime = activeSet->rrTime;
+    unsigned int size = activeSet->size;
+    unsigned int first = size;
+    unsigned int i = 0;
+
+    // vector loop: remaining -= min(remaining, elapsed); finished if remaining is 0; expired if rr time >= quantum
+#if defined(__AVX2__)
+    __m256i elapsedVec = _mm256_set1_epi32(elapsed);
+    __m256i quantumVec = _mm256_set1_epi32(rrQuantum);
+    __m256i zeroVec = _mm256_setzero_si256();
+    for (; i + ACTIVE_SET_LANES <= size; i += ACTIVE_SET_LANES) {
+        __m256i remVec = _mm256_loadu_si256((__m256i*)(remainingTime + i));
+        remVec = _mm256_sub_epi32(remVec, _mm256_min_epu32(remVec, elapsedVec));
+        _mm256_storeu_si256((__m256i*)(remainingTime + i), remVec);
+        __m256i flagVec = _mm256_cmpeq_epi32(remVec, zeroVec);
+        if (isRR) {
+            __m256i rrVec = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(rrTime + i)), elapsedVec);
+            _mm256_storeu_si256((__m256i*)(rrTime + i), rrVec);
+            flagVec = _mm256_or_si256(flagVec, _mm256_cmpeq_epi32(_mm256_max_epu32(rrVec, quantumVec), rrVec));
+        }
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(flagVec));
+        if (mask != 0 && first == size) first = i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE4_1__)
+    __m128i elapsedVec = _mm_set1_epi32(elapsed);
+    __m128i quantumVec = _mm_set1_epi32(rrQuantum);
+    __m128i zeroVec = _mm_setzero_si128();
+    for (; i + ACTIVE_SET_LANES <= size; i += ACTIVE_SET_LANES) {
+        __m128i remVec = _mm_loadu_si128((__m128i*)(remainingTime + i));
+        remVec = _mm_sub_epi32(remVec, _mm_min_epu32(remVec, elapsedVec));
+        _mm_storeu_si128((__m128i*)(remainingTime + i), remVec);
+        __m128i flagVec = _mm_cmpeq_epi32(remVec, zeroVec);
+        if (isRR) {
+            __m128i rrVec = _mm_add_epi32(_mm_loadu_si128((__m128i*)(rrTime + i)), elapsedVec);
+            _mm_storeu_si128((__m128i*)(rrTime + i), rrVec);
+            flagVec = _mm_or_si128(flagVec, _mm_cmpeq_epi32(_mm_max_epu32(rrVec, quantumVec), rrVec));
+        }
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(flagVec));
+        if (mask != 0 && first == size) first = i + __builtin_ctz(mask);
+    }
+#elif defined(__wasm_simd128__)
+    v128_t elapsedVec = wasm_i32x4_splat(elapsed);
+    v128_t quantumVec = wasm_i32x4_splat(rrQuantum);
+    v128_t zeroVec = wasm_i32x4_splat(0);
+    for (; i + ACTIVE_SET_LANES <= size; i += ACTIVE_SET_LANES) {
+        v128_t remVec = wasm_v128_load(remainingTime + i);
+        remVec = wasm_i32x4_sub(remVec, wasm_u32x4_min(remVec, elapsedVec));
+        wasm_v128_store(remainingTime + i, remVec);
+        v128_t flagVec = wasm_i32x4_eq(remVec, zeroVec);
+        if (isRR) {
+            v128_t rrVec = wasm_i32x4_add(wasm_v128_load(rrTime + i), elapsedVec);
+            wasm_v128_store(rrTime + i, rrVec);
+            flagVec = wasm_v128_or(flagVec, wasm_u32x4_ge(rrVec, quantumVec));
+        }
+        int mask = wasm_i32x4_bitmask(flagVec);
+        if (mask != 0 && first == size) first = i + __builtin_ctz(mask);
+    }
+#endif
+
+    // scalar loop (remainder, or everything without a vector unit)
+    for (; i < size; i++) {
+        remainingTime[i] -= remainingTime[i] < elapsed ? remainingTime[i] : elapsed;
+        char isFlagged = remainingTime[i] == 0;
+        if (isRR) {
+            rrTime[i] += elapsed;
+            isFlagged |= rrTime[i] >= rrQuantum;
+        }
+        if (isFlagged && first == size) first = i;
+    }
+    return first;
+}
+
+// returns the shortest time until any process finishes or uses up its quantum (UINT_MAX if the set is empty)
+unsigned int getActiveRunTime(ActiveSet* activeSet, unsigned int rrQuantum, char isRR) {
+
+    unsigned int* remainingTime = activeSet->remainingTime;
+    unsigned int* rrTime = activeSet->rrTime;
+    unsigned int size = activeSet->size;
+    unsigned int minTime = UINT_MAX;
+    unsigned int i = 0;
+
+    // vector loop: lane-wise minimum of min(remaining, quantum - rr time), reduced at the end
+#if ACTIVE_SET_LANES > 1
+    unsigned int lanes[ACTIVE_SET_LANES];
+#endif
+#if defined(__AVX2__)
+    __m256i quantumVec = _mm256_set1_epi32(rrQuantum);
+    __m256i minVec = _mm256_set1_epi32(-1);
+    for (; i + ACTIVE_SET_LANES <= size; i += ACTIVE_SET_LANES) {
+        __m256i timeVec = _mm256_loadu_si256((__m256i*)(remainingTime + i));
+        if (isRR) timeVec = _mm256_min_epu32(timeVec, _mm256_sub_epi32(quantumVec, _mm256_loadu_si256((__m256i*)(rrTime + i))));
+        minVec = _mm256_min_epu32(minVec, timeVec);
+    }
+    _mm256_storeu_si256((__m256i*)lanes, minVec);
+#elif defined(__SSE4_1__)
+    __m128i quantumVec = _mm_set1_epi32(rrQuantum);
+    __m128i minVec = _mm_set1_epi32(-1);
+    for (; i + ACTIVE_SET_LANES <= size; i += ACTIVE_SET_LANES) {
+        __m128i timeVec = _mm_loadu_si128((__m128i*)(remainingTime + i));
+        if (isRR) timeVec = _mm_min_epu32(timeVec, _mm_sub_epi32(quantumVec, _mm_loadu_si128((__m128i*)(rrTime + i))));
+        minVec = _mm_min_epu32(minVec, timeVec);
+    }
+    _mm_storeu_si128((__m128i*)lanes, minVec);
+#elif defined(__wasm_simd128__)
+    v128_t quantumVec = wasm_i32x4_splat(rrQuantum);
+    v128_t minVec = wasm_i32x4_splat(-1);
+    for (; i + ACTIVE_SET_LANES <= size; i += ACTIVE_SET_LANES) {
+        v128_t timeVec = wasm_v128_load(remainingTime + i);
+        if (isRR) timeVec = wasm_u32x4_min(timeVec, wasm_i32x4_sub(quantumVec, wasm_v128_load(rrTime + i)));
+        minVec = wasm_u32x4_min(minVec, timeVec);
+    }
+    wasm_v128_store(lanes, minVec);
+#endif
+#if ACTIVE_SET_LANES > 1
+    for (int lane = 0; lane < ACTIVE_SET_LANES; lane++)
+        if (lanes[lane] < minTime) minTime = lanes[lane];
+#endif
+
+    // scalar loop (remainder, or everything without a vector unit)
+    for (; i < size; i++) {
+        unsigned int runTime = remainingTime[i];
+        if (isRR && rrQuantum - rrTime[i] < runTime) runTime = rrQuantum - rrTime[i];
+        if (runTime < minTime) minTime = runTime;
+    }
+    return minTime;
+}
+
+void freeActiveSet(ActiveSet activeSet) {
+
+    free(activeSet.nodes);
+}
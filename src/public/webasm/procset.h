@@ -0,0 +1,33 @@
+// This header file represents the set of running processes as a structure of arrays.
+// Per-event updates then run over contiguous arrays (vectorized where the build allows) instead of chasing one node pointer per CPU.
+
+#ifndef PROCSET_H
+#define PROCSET_H
+
+#include "proclist.h"
+
+// running processes in dispatch order (at most one per CPU); while a process runs, its times live here rather than in its node
+typedef struct ActiveSet {
+
+    struct ProcessNode** nodes;  // owning nodes (null if the set could not be allocated)
+    unsigned int* pid;
+    unsigned int* remainingTime;
+    unsigned int* rrTime;
+    unsigned int size;
+    unsigned int capacity;
+
+} ActiveSet;
+
+ActiveSet createActiveSet(unsigned int capacity);
+
+void addActiveProcess(ActiveSet* activeSet, ProcessNode* procNode);
+ProcessNode* removeActiveProcess(ActiveSet* activeSet, unsigned int index); // writes times back to the node
+unsigned int findActiveProcess(ActiveSet* activeSet, ProcessNode* procNode); // returns size if not found
+void compactActiveSet(ActiveSet* activeSet, unsigned int first); // drops processes whose node was cleared
+
+unsigned int tickActiveSet(ActiveSet* activeSet, unsigned int elapsed, unsigned int rrQuantum, char isRR);
+unsigned int getActiveRunTime(ActiveSet* activeSet, unsigned int rrQuantum, char isRR);
+
+void freeActiveSet(ActiveSet activeSet);
+
+#endif
@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include "procsim.h"
+#include "spmlimits.h"
+#include <stdlib.h>
+
+// same input format as getFrames; returns null on failure (see spmGetError; free with spmDestroy)
+SimHandle* spmCreate(char* str) {
+
+    // init new handle
+    SimHandle* handle = malloc(sizeof(SimHandle));
+    if (handle == NULL) {
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    handle->ring = NULL;
+    handle->isStarted = 1;
+
+    // create process manager from parsed data
+    handle->procMgr = parseManagerFromString(str);
+    if (handle->procMgr == NULL) {
+        LOG_ERROR("ERROR: could not generate process manager\n");
+        free(handle);
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+
+    // allocate the single frame that is rewritten on every read
+    handle->frameLength = 1 + 2 * handle->procMgr->numCpus;
+    handle->frame = malloc(sizeof(unsigned int) * handle->frameLength);
+    if (handle->frame == NULL) {
+        spmDestroy(handle);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // sort unstarted processes by start time
+    if (sortProcessList(&handle->procMgr->unstarted)) {
+        spmDestroy(handle);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // handle the first event (an empty workload has no frames at all)
+    handle->frameTime = 0;
+    handle->hasFrame = hasPendingProcesses(handle->procMgr);
+    if (handle->hasFrame) {
+        runEvent(handle->procMgr);
+        if (handle->procMgr->errFlag) {
+            setEngineError(handle->procMgr->errFlag);
+            spmDestroy(handle);
+            return NULL;
+        }
+    }
+
+    // return handle
+    setEngineError(SPM_OK);
+    return handle;
+}
+
+// starts an empty simulation whose processes are submitted through a ring of 'ringCapacity' entries (1 to MAX_RING_CAPACITY) while it runs; returns null on failure (free with spmDestroy)
+// the producer pushes with pushProcess (or writes the ring from JS) and closes the ring after its last process; the simulation finishes once the ring is closed and every process is done
+SimHandle* spmCreateLive(const SimConfig* config, unsigned int ringCapacity) {
+
+    // init new handle (the first event waits for the first read or step)
+    SimHandle* handle = malloc(sizeof(SimHandle));
+    if (handle == NULL) {
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    *handle = (SimHandle){ .procMgr = NULL, .frameTime = 0, .frame = NULL, .hasFrame = 1, .ring = NULL, .isStarted = 0 };
+
+    // create empty process manager (sets the engine error)
+    handle->procMgr = createManagerFromArray(config, NULL, 0);
+    if (handle->procMgr == NULL) {
+        free(handle);
+        return NULL;
+    }
+
+    // allocate frame and ring
+    handle->frameLength = 1 + 2 * handle->procMgr->numCpus;
+    handle->frame = malloc(sizeof(unsigned int) * handle->frameLength);
+    handle->ring = createProcessRing(ringCapacity);
+    if (handle->frame == NULL || handle->ring == NULL) {
+        spmDestroy(handle);
+        setEngineError(ringCapacity == 0 || ringCapacity > MAX_RING_CAPACITY ? SPM_ERR_SETTINGS : SPM_ERR_MEMORY);
+        return NULL;
+    }
+    return handle;
+}
+
+// returns the ring a live simulation takes its processes from (null if it is not live)
+ProcessRing* spmGetRing(SimHandle* handle) {
+
+    return handle->ring;
+}
+
+// moves submitted processes from the ring to the unstarted list (kept in start time order); returns the number moved or -1 on failure
+// frames already read cannot change, so once started a submission starts no earlier than the next second (and may bring the next event forward)
+static int drainRing(SimHandle* handle) {
+
+    ProcessManager* procMgr = handle->procMgr;
+    unsigned long long minStartTime = handle->isStarted ? handle->frameTime + 1 : 0;
+    int hasPending = hasPendingProcesses(procMgr);
+
+    // take at most one lap per call, so a fast producer cannot keep the simulation here
+    unsigned int entries[RING_ENTRY_WORDS * RING_DRAIN_BATCH];
+    unsigned int maxCount = handle->ring->mask + 1;
+    unsigned int numDrained = 0;
+    while (numDrained < maxCount) {
+        unsigned int count = popProcesses(handle->ring, entries, maxCount - numDrained < RING_DRAIN_BATCH ? maxCount - numDrained : RING_DRAIN_BATCH);
+        if (count == 0) break;
+        for (unsigned int i = 0; i < count; i++) {
+            const unsigned int* params = entries + RING_ENTRY_WORDS * i;
+            unsigned long long startTime = params[1] < minStartTime ? minStartTime : params[1];
+            if (startTime > MAX_TIME_AND_PID) {
+                setEngineError(SPM_ERR_LIMIT);
+                return -1;
+            }
+            if (insertProcessByStartTime(&procMgr->unstarted, (Process){ .pid = params[0], .startTime = startTime, .duration = params[2], .remainingTime = params[2], .rrTime = 0 }) == NULL) {
+                setEngineError(SPM_ERR_MEMORY);
+                return -1;
+            }
+            if (handle->isStarted && (!hasPending || startTime < procMgr->nextTime))
+                procMgr->nextTime = startTime;
+            hasPending = 1;
+        }
+        numDrained += count;
+    }
+    return (int)numDrained;
+}
+
+// runs a live simulation's first event once the processes submitted so far are taken (they may start at 0); returns 1 on failure
+static int startLive(SimHandle* handle) {
+
+    if (drainRing(handle) < 0) return 1;
+    handle->isStarted = 1;
+
+    // a ring closed without any process has no frames at all (like an empty workload)
+    handle->hasFrame = hasPendingProcesses(handle->procMgr) || !isProcessRingClosed(handle->ring);
+    if (handle->hasFrame) {
+        runEvent(handle->procMgr);
+        if (handle->procMgr->errFlag) {
+            setEngineError(handle->procMgr->errFlag);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// takes a live simulation's submissions now (spmStep also takes them every second); returns the number taken or -1 on failure
+// before the first read or step this does not start the simulation, so a producer can be waited on until its processes starting at 0 are in
+int spmPoll(SimHandle* handle) {
+
+    if (handle->ring == NULL) return 0;
+    return drainRing(handle);
+}
+
+// advances up to numFrames seconds, handling events as they are reached; returns the number of frames advanced (0 once finished) or -1 on failure
+// a live simulation takes submissions every second, and keeps stepping through idle seconds until its ring is closed
+int spmStep(SimHandle* handle, unsigned int numFrames) {
+
+    ProcessManager* procMgr = handle->procMgr;
+    if (!handle->isStarted && startLive(handle)) return -1;
+    unsigned int numStepped = 0;
+    while (numStepped < numFrames) {
+
+        // take live submissions
+        if (handle->ring != NULL && drainRing(handle) < 0) return -1;
+
+        // the frame of the last event is the last frame
+        if (!hasPendingProcesses(procMgr)) {
+            if (handle->ring == NULL || isProcessRingClosed(handle->ring)) break;
+            handle->frameTime++;
+            numStepped++;
+            continue;
+        }
+
+        // skip idle seconds up to the next event (or as many as requested; live, one at a time since any second may bring a submission)
+        unsigned long long numIdle = procMgr->nextTime - handle->frameTime;
+        if (numIdle > numFrames - numStepped) numIdle = numFrames - numStepped;
+        if (handle->ring != NULL && numIdle > 1) numIdle = 1;
+        handle->frameTime += numIdle;
+        numStepped += numIdle;
+
+        // handle the next event once it is reached
+        if (handle->frameTime == procMgr->nextTime) {
+            advanceClock(procMgr);
+            runEvent(procMgr);
+            if (procMgr->errFlag) {
+                setEngineError(procMgr->errFlag);
+                return -1;
+            }
+        }
+    }
+    return numStepped;
+}
+
+// writes the current frame; returns it (valid until the next read) or null if there are no frames
+unsigned int* spmReadFrame(SimHandle* handle) {
+
+    if (!handle->isStarted && startLive(handle)) return NULL;
+    if (!handle->hasFrame) return NULL;
+    START_PHASE(frame);
+    writeFrameData(handle->procMgr, handle->frame, handle->frameTime - handle->procMgr->time);
+    handle->procMgr->engineStats.framesEmitted++;
+    END_PHASE(handle->procMgr, frame);
+    return handle->frame;
+}
+
+void spmDestroy(SimHandle* handle) {
+
+    // free process manager, frame and ring
+    if (handle->procMgr != NULL) freeProcessManager(handle->procMgr);
+    free(handle->frame);
+    freeProcessRing(handle->ring);
+
+    // free handle itself
+    free(handle);
+}
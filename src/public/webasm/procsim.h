@@ -0,0 +1,37 @@
+// This header file represents a stepped simulation: a process manager that only computes frames as they are read.
+// Memory stays bounded by the workload (not the simulation length), and the first frame is available as soon as the input is parsed.
+// A live simulation starts empty and takes processes from a ring (see procring.h) that another thread fills while it is stepped.
+
+#ifndef PROCSIM_H
+#define PROCSIM_H
+
+#include "procmgr.h"
+#include "procring.h"
+
+// most ring entries moved to the unstarted list per batch
+#define RING_DRAIN_BATCH 256
+
+// simulation handle
+typedef struct SimHandle {
+
+    struct ProcessManager* procMgr;
+    unsigned long long frameTime; // time of the current frame (between the current and next event)
+    unsigned int* frame;          // current frame in the binary frame layout (see framebuf.h)
+    unsigned int frameLength;     // words per frame
+    char hasFrame;                // 0 for an empty workload (no frames at all)
+
+    // live submissions (null unless created with spmCreateLive)
+    struct ProcessRing* ring;
+    char isStarted;               // live only: the first event waits for the first read or step, so processes submitted before it can start at 0
+
+} SimHandle;
+
+SimHandle* spmCreate(char* str);
+SimHandle* spmCreateLive(const SimConfig* config, unsigned int ringCapacity);
+ProcessRing* spmGetRing(SimHandle* handle);
+int spmPoll(SimHandle* handle);
+int spmStep(SimHandle* handle, unsigned int numFrames);
+unsigned int* spmReadFrame(SimHandle* handle);
+void spmDestroy(SimHandle* handle);
+
+#endif
@@ -0,0 +1,119 @@
+#include "procstats.h"
+#include <stdlib.h>
+#include <math.h>
+
+// returns null on allocation failure
+ProcessStats* createProcessStats() {
+
+    // init zeroed stats
+    return calloc(1, sizeof(ProcessStats));
+}
+
+// maps a value to its histogram bucket
+unsigned int getHistogramBucket(unsigned long long value) {
+
+    // exact buckets
+    if (value < HISTOGRAM_EXACT_LIMIT) return value;
+
+    // log-linear buckets (power of two, then the next bits below the leading one)
+    unsigned int exponent = 63 - __builtin_clzll(value);
+    unsigned int sub = (value >> (exponent - HISTOGRAM_SUB_BITS)) & ((1 << HISTOGRAM_SUB_BITS) - 1);
+    return HISTOGRAM_EXACT_LIMIT + (exponent - 4) * (1 << HISTOGRAM_SUB_BITS) + sub;
+}
+
+// maps a histogram bucket back to the middle of the values it holds
+double getHistogramBucketValue(unsigned int bucket) {
+
+    // exact buckets
+    if (bucket < HISTOGRAM_EXACT_LIMIT) return bucket;
+
+    // log-linear buckets
+    unsigned int exponent = (bucket - HISTOGRAM_EXACT_LIMIT) / (1 << HISTOGRAM_SUB_BITS) + 4;
+    unsigned int sub = (bucket - HISTOGRAM_EXACT_LIMIT) % (1 << HISTOGRAM_SUB_BITS);
+    double width = (double)(1ull << (exponent - HISTOGRAM_SUB_BITS));
+    return (double)(1ull << exponent) + sub * width + (width - 1) / 2;
+}
+
+void addHistogramValue(TimeHistogram* hist, unsigned long long value) {
+
+    hist->count++;
+    hist->sum += value;
+    if (value > hist->max) hist->max = value;
+    hist->buckets[getHistogramBucket(value)]++;
+}
+
+// percentile in [0, 100]; returns 0 for an empty histogram
+double getHistogramPercentile(TimeHistogram* hist, double percentile) {
+
+    // return 0 for empty histogram
+    if (hist->count == 0) return 0;
+
+    // find bucket holding the ranked value (nearest rank)
+    unsigned long long rank = (unsigned long long)ceil(percentile / 100 * hist->count);
+    if (rank < 1) rank = 1;
+    unsigned long long seen = 0;
+    for (unsigned int i = 0; i < NUM_HISTOGRAM_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            double value = getHistogramBucketValue(i);
+            return value < hist->max ? value : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+void recordDispatch(ProcessStats* stats, unsigned long long time, unsigned int startTime, char isFirstRun) {
+
+    stats->dispatches++;
+    if (isFirstRun) addHistogramValue(&stats->response, time - startTime);
+}
+
+void recordPreemption(ProcessStats* stats) {
+
+    stats->preemptions++;
+}
+
+void recordCompletion(ProcessStats* stats, unsigned long long time, unsigned int startTime, unsigned int duration) {
+
+    // time spent waiting is whatever part of the turnaround was not spent running
+    unsigned long long turnaround = time - startTime;
+    addHistogramValue(&stats->turnaround, turnaround);
+    addHistogramValue(&stats->waiting, turnaround > duration ? turnaround - duration : 0);
+
+    stats->numProcesses++;
+    stats->busyTime += duration;
+    if (time > stats->makespan) stats->makespan = time;
+}
+
+// summarize one histogram
+MetricSummary summarizeHistogram(TimeHistogram* hist) {
+
+    return (MetricSummary){
+        .avg = hist->count ? (double)hist->sum / hist->count : 0,
+        .p50 = getHistogramPercentile(hist, 50),
+        .p90 = getHistogramPercentile(hist, 90),
+        .p99 = getHistogramPercentile(hist, 99),
+        .max = hist->max
+    };
+}
+
+SimMetrics summarizeProcessStats(ProcessStats* stats, unsigned int numCpus) {
+
+    return (SimMetrics){
+        .numProcesses = stats->numProcesses,
+        .makespan = stats->makespan,
+        .busyTime = stats->busyTime,
+        .cpuUtilization = stats->makespan ? (double)stats->busyTime / ((double)numCpus * stats->makespan) : 0,
+        .throughput = stats->makespan ? (double)stats->numProcesses / stats->makespan : 0,
+        .contextSwitches = stats->dispatches,
+        .preemptions = stats->preemptions,
+        .waitingTime = summarizeHistogram(&stats->waiting),
+        .turnaroundTime = summarizeHistogram(&stats->turnaround),
+        .responseTime = summarizeHistogram(&stats->response)
+    };
+}
+
+void freeProcessStats(ProcessStats* stats) {
+
+    free(stats);
+}
@@ -0,0 +1,78 @@
+// This header file represents scheduling statistics that are updated in place while a simulation runs.
+// Percentiles come from fixed-size log-linear histograms, so the cost per process is constant and no per-process history is kept.
+
+#ifndef PROCSTATS_H
+#define PROCSTATS_H
+
+// histogram layout: values below 16 get exact buckets; larger values get 8 buckets per power of two (at most 1/8 relative error)
+#define HISTOGRAM_SUB_BITS 3
+#define HISTOGRAM_EXACT_LIMIT 16
+#define NUM_HISTOGRAM_BUCKETS (HISTOGRAM_EXACT_LIMIT + (64 - 4) * (1 << HISTOGRAM_SUB_BITS))
+
+// histogram of times (seconds)
+typedef struct TimeHistogram {
+
+    unsigned long long count;
+    unsigned long long sum;
+    unsigned long long max;
+    unsigned long long buckets[NUM_HISTOGRAM_BUCKETS];
+
+} TimeHistogram;
+
+// running statistics (updated as processes start, get preempted and finish)
+typedef struct ProcessStats {
+
+    unsigned long long numProcesses; // finished processes
+    unsigned long long makespan;     // time the last process finished
+    unsigned long long busyTime;     // cpu seconds spent running processes
+    unsigned long long dispatches;   // processes loaded onto a CPU (context switches)
+    unsigned long long preemptions;  // processes moved back to the queue before finishing
+
+    struct TimeHistogram waiting;    // turnaround - duration
+    struct TimeHistogram turnaround; // finish - start
+    struct TimeHistogram response;   // first dispatch - start
+
+} ProcessStats;
+
+// summary of one time histogram
+typedef struct MetricSummary {
+
+    double avg;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+
+} MetricSummary;
+
+// final metrics (all fields are doubles so JS can read the struct as a Float64Array; do not reorder)
+typedef struct SimMetrics {
+
+    double numProcesses;
+    double makespan;
+    double busyTime;
+    double cpuUtilization; // busyTime / (numCpus * makespan)
+    double throughput;     // finished processes per second
+    double contextSwitches;
+    double preemptions;
+
+    struct MetricSummary waitingTime;
+    struct MetricSummary turnaroundTime;
+    struct MetricSummary responseTime;
+
+} SimMetrics;
+
+ProcessStats* createProcessStats();
+
+void addHistogramValue(TimeHistogram* hist, unsigned long long value);
+double getHistogramPercentile(TimeHistogram* hist, double percentile);
+
+void recordDispatch(ProcessStats* stats, unsigned long long time, unsigned int startTime, char isFirstRun);
+void recordPreemption(ProcessStats* stats);
+void recordCompletion(ProcessStats* stats, unsigned long long time, unsigned int startTime, unsigned int duration);
+
+SimMetrics summarizeProcessStats(ProcessStats* stats, unsigned int numCpus);
+
+void freeProcessStats(ProcessStats* stats);
+
+#endif
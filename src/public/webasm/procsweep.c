@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include "procsweep.h"
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#else
+#include <unistd.h>
+#endif
+
+// state shared by the sweep threads (rows are claimed one at a time, so uneven configurations still balance)
+typedef struct SweepJob {
+
+    ProcessList* procList; // sorted workload (read only while the sweep runs)
+    SweepTable* table;
+    atomic_uint nextRow;
+    atomic_int errFlag;
+
+} SweepJob;
+
+// returns 0 if the ranges are invalid
+unsigned long long getNumSweepConfigs(SweepParams params) {
+
+    // verify ranges (at least one CPU and a positive quantum)
+    if (params.minCpus < 1 || params.minCpus > params.maxCpus || params.maxCpus > MAX_NUM_CPUS ||
+        params.minQuantum < 1 || params.minQuantum > params.maxQuantum)
+        return 0;
+
+    // every algorithm once per CPU count, plus every quantum for the algorithms that take one
+    unsigned long long numCpus = params.maxCpus - params.minCpus + 1;
+    unsigned long long numQuanta = (unsigned long long)params.maxQuantum - params.minQuantum + 1;
+    return numCpus * (NUM_ALGS - NUM_QUANTUM_ALGS + NUM_QUANTUM_ALGS * numQuanta);
+}
+
+// number of hardware threads available to the sweep
+unsigned int getNumCores() {
+
+#ifdef __EMSCRIPTEN__
+    int numCores = emscripten_num_logical_cores();
+#else
+    long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return numCores > 0 ? (unsigned int)numCores : 1;
+}
+
+// simulates one configuration on a private copy of the workload; returns 1 on failure
+char runSweepRow(ProcessList* procList, SweepRow* row) {
+
+    // create process manager collecting statistics only
+    ProcessManager* procMgr = createProcessManager((unsigned int)row->numCpus, (enum Algorithms)row->alg, (unsigned int)row->rrQuantum);
+    if (procMgr == NULL) return 1;
+    procMgr->stats = createProcessStats();
+    char failed = procMgr->stats == NULL;
+
+    // copy sorted processes into the manager's own pool (threads never share a mutable list)
+    for (ProcessNode* curNode = procList->head; curNode != NULL && !failed; curNode = curNode->next)
+        failed = addProcessBack(&procMgr->unstarted, curNode->process) == NULL;
+
+    // run and summarize
+    if (!failed) {
+        runAlgorithm(procMgr);
+        failed = procMgr->errFlag;
+    }
+    if (!failed)
+        row->metrics = summarizeProcessStats(procMgr->stats, procMgr->numCpus);
+
+    // free process manager
+    freeProcessManager(procMgr);
+    return failed;
+}
+
+// claims and runs rows until none are left (or one failed)
+void* sweepWorker(void* arg) {
+
+    SweepJob* job = arg;
+    unsigned int numRows = (unsigned int)job->table->numRows;
+    for (unsigned int i = atomic_fetch_add(&job->nextRow, 1); i < numRows && !atomic_load(&job->errFlag); i = atomic_fetch_add(&job->nextRow, 1)) {
+        if (runSweepRow(job->procList, &job->table->rows[i]))
+            atomic_store(&job->errFlag, 1);
+    }
+    return NULL;
+}
+
+// runs every configuration in the ranges on up to numThreads threads (0 = one per core); returns null on failure (see spmGetError; free with free)
+SweepTable* runSweep(ProcessList* procList, SweepParams params, unsigned int numThreads) {
+
+    // verify configuration count
+    unsigned long long numRows = getNumSweepConfigs(params);
+    if (numRows == 0 || numRows > MAX_SWEEP_CONFIGS) {
+        setEngineError(SPM_ERR_SETTINGS);
+        return NULL;
+    }
+
+    // allocate table
+    SweepTable* table = malloc(sizeof(SweepTable) + numRows * sizeof(SweepRow));
+    if (table == NULL) {
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    table->numRows = numRows;
+
+    // list configurations (algorithm major, then CPU count, then quantum)
+    unsigned int row = 0;
+    for (unsigned int alg = 0; alg < NUM_ALGS; alg++) {
+        for (unsigned int numCpus = params.minCpus; numCpus <= params.maxCpus; numCpus++) {
+            unsigned int maxQuantum = USES_QUANTUM(alg) ? params.maxQuantum : params.minQuantum;
+            for (unsigned long long rrQuantum = params.minQuantum; rrQuantum <= maxQuantum; rrQuantum++)
+                table->rows[row++] = (SweepRow){ .alg = alg, .numCpus = numCpus, .rrQuantum = USES_QUANTUM(alg) ? rrQuantum : 0 };
+        }
+    }
+
+    // sort the workload once for every configuration
+    if (sortProcessList(procList)) {
+        free(table);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+
+    // use one thread per core by default, but no more than there are rows
+    if (numThreads == 0) numThreads = getNumCores();
+    if (numThreads > MAX_SWEEP_THREADS) numThreads = MAX_SWEEP_THREADS;
+    if (numThreads > numRows) numThreads = numRows;
+
+    // start workers (the calling thread works too, so the sweep still completes if threads are unavailable)
+    SweepJob job = { .procList = procList, .table = table };
+    atomic_init(&job.nextRow, 0);
+    atomic_init(&job.errFlag, 0);
+    pthread_t threads[MAX_SWEEP_THREADS];
+    unsigned int numStarted = 0;
+    while (numStarted + 1 < numThreads && pthread_create(&threads[numStarted], NULL, sweepWorker, &job) == 0)
+        numStarted++;
+    sweepWorker(&job);
+
+    // wait for workers
+    for (unsigned int i = 0; i < numStarted; i++)
+        pthread_join(threads[i], NULL);
+
+    // fail if any configuration failed (sweeps collect metrics only, so only an allocation can fail)
+    if (atomic_load(&job.errFlag)) {
+        free(table);
+        setEngineError(SPM_ERR_MEMORY);
+        return NULL;
+    }
+    setEngineError(SPM_OK);
+    return table;
+}
+
+// sweep string format: minCpus,maxCpus,minQuantum,maxQuantum,pid,start,duration,...; returns null on failure (see spmGetError; free with free)
+SweepTable* getSweep(char* str, unsigned int numThreads) {
+
+    // define array of params (wide enough to detect values over the 32-bit limit) and token type to index
+    unsigned long long params[] = { 0, 0, 0, 0 };
+    unsigned int tokenType = 0;
+    size_t i;
+    for (i = 0; str[i] != '\0'; i++) {
+
+        // valid; add digit to current token type number (invalid if over limit)
+        if (str[i] >= '0' && str[i] <= '9') {
+            params[tokenType] = params[tokenType] * 10 + (str[i] - '0');
+            if (params[tokenType] > MAX_TIME_AND_PID) {
+                setEngineError(SPM_ERR_SETTINGS);
+                return NULL;
+            }
+
+        // valid; terminate field
+        } else if (str[i] == ',') {
+
+            // end of ranges
+            if (tokenType == 3) break;
+
+            // increment token type
+            tokenType++;
+
+        // invalid character; return null
+        } else {
+            setEngineError(SPM_ERR_INPUT);
+            return NULL;
+        }
+    }
+    if (str[i] == '\0') {
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+
+    // parse processes once into a pool owned by the sweep (malformed process text parses to an empty list, which must not run as an empty workload)
+    ProcessPool procPool = createProcessPool();
+    ProcessList procList = parseListFromString(str + (sizeof(char) * (i + 1)), &procPool);
+    if (procList.size == 0 && str[i + 1] != '\0') {
+        freeProcessPool(&procPool);
+        setEngineError(SPM_ERR_INPUT);
+        return NULL;
+    }
+
+    // run every configuration
+    SweepParams sweepParams = { .minCpus = params[0], .maxCpus = params[1], .minQuantum = params[2], .maxQuantum = params[3] };
+    SweepTable* table = runSweep(&procList, sweepParams, numThreads);
+
+    // free workload
+    freeProcessPool(&procPool);
+    return table;
+}
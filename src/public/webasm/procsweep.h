@@ -0,0 +1,43 @@
+// This header file represents parameter sweeps: one parsed workload simulated under every algorithm, CPU count and round robin quantum in a range.
+// Configurations are independent, so they are handed out to a pool of threads (pthreads natively, Emscripten pthreads in the browser).
+
+#ifndef PROCSWEEP_H
+#define PROCSWEEP_H
+
+#include "procmgr.h"
+
+// sweep ranges (both ends inclusive; quanta only apply to round robin)
+typedef struct SweepParams {
+
+    unsigned int minCpus;
+    unsigned int maxCpus;
+    unsigned int minQuantum;
+    unsigned int maxQuantum;
+
+} SweepParams;
+
+// one configuration and its metrics (all fields are doubles so JS can read rows as a Float64Array; do not reorder)
+typedef struct SweepRow {
+
+    double alg;
+    double numCpus;
+    double rrQuantum; // 0 for algorithms without a quantum
+    struct SimMetrics metrics;
+
+} SweepRow;
+
+// result table
+typedef struct SweepTable {
+
+    double numRows;
+    struct SweepRow rows[];
+
+} SweepTable;
+
+unsigned long long getNumSweepConfigs(SweepParams params);
+unsigned int getNumCores();
+
+SweepTable* runSweep(ProcessList* procList, SweepParams params, unsigned int numThreads);
+SweepTable* getSweep(char* str, unsigned int numThreads);
+
+#endif
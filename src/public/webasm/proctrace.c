@@ -0,0 +1,200 @@
+#include "proctrace.h"
+#include "spmlimits.h"
+#include "spmparse.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// maps a trace file and detects its format; returns null on failure (errno is set)
+TraceReader* openTrace(const char* path) {
+
+    // open and size file
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // init new reader
+    TraceReader* trace = malloc(sizeof(TraceReader));
+    if (trace == NULL) {
+        close(fd);
+        return NULL;
+    }
+    *trace = (TraceReader){ .data = NULL, .size = fileStat.st_size, .format = TRACE_CSV, .lineNumber = 1, .isSorted = 1, .error = TRACE_OK };
+
+    // map the whole file (read once, front to back); the mapping outlives the descriptor
+    if (trace->size > 0) {
+        void* data = mmap(NULL, trace->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            free(trace);
+            return NULL;
+        }
+        madvise(data, trace->size, MADV_SEQUENTIAL);
+        trace->data = data;
+    }
+    close(fd);
+
+    // binary traces carry a magic; skip a CSV header line
+    if (trace->size >= TRACE_MAGIC_LEN && memcmp(trace->data, TRACE_MAGIC, TRACE_MAGIC_LEN) == 0) {
+        trace->format = TRACE_BINARY;
+        trace->pos = TRACE_MAGIC_LEN;
+    } else if (trace->size > 0 && (trace->data[0] < '0' || trace->data[0] > '9')) {
+        const char* lineEnd = memchr(trace->data, '\n', trace->size);
+        trace->pos = lineEnd != NULL ? (size_t)(lineEnd - trace->data) + 1 : trace->size;
+        trace->lineNumber = 2;
+    }
+    return trace;
+}
+
+// hands parsed pages back to the kernel (they are clean, so this only drops them from memory)
+static void releaseParsedPages(TraceReader* trace) {
+
+    if (trace->pos - trace->releasedPos < TRACE_RELEASE_BYTES) return;
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t releaseEnd = trace->pos / pageSize * pageSize;
+    madvise((void*)(trace->data + trace->releasedPos), releaseEnd - trace->releasedPos, MADV_DONTNEED);
+    trace->releasedPos = releaseEnd;
+}
+
+// parses one CSV record ('pid,start,duration' ended by a newline or the end of the file; empty lines are skipped)
+// returns 1 if a record was parsed, 0 at the end of the file, -1 on error
+static int parseCsvRecord(TraceReader* trace, unsigned long long* params) {
+
+    // skip empty lines
+    const char* data = trace->data;
+    while (trace->pos < trace->size && (data[trace->pos] == '\n' || data[trace->pos] == '\r')) {
+        if (data[trace->pos] == '\n') trace->lineNumber++;
+        trace->pos++;
+    }
+    if (trace->pos == trace->size) return 0;
+
+    // three fields separated by commas
+    for (int field = 0; field < 3; field++) {
+        size_t numDigits = parseDecimal(data + trace->pos, trace->size - trace->pos, &params[field]);
+        trace->pos += numDigits;
+        if (numDigits == 0) {
+            trace->error = TRACE_ERR_FORMAT;
+            return -1;
+        }
+        if (params[field] > MAX_TIME_AND_PID) {
+            trace->error = TRACE_ERR_RANGE;
+            return -1;
+        }
+        if (field < 2) {
+            if (trace->pos == trace->size || data[trace->pos] != ',') {
+                trace->error = TRACE_ERR_FORMAT;
+                return -1;
+            }
+            trace->pos++;
+        }
+    }
+
+    // end of line (CRLF or LF) or of file
+    if (trace->pos < trace->size && data[trace->pos] == '\r') trace->pos++;
+    if (trace->pos < trace->size) {
+        if (data[trace->pos] != '\n') {
+            trace->error = TRACE_ERR_FORMAT;
+            return -1;
+        }
+        trace->pos++;
+    }
+    trace->lineNumber++;
+    return 1;
+}
+
+// reads one binary record; returns 1 if a record was read, 0 at the end of the file, -1 on error
+static int readBinaryRecord(TraceReader* trace, unsigned long long* params) {
+
+    if (trace->pos == trace->size) return 0;
+    if (trace->size - trace->pos < TRACE_RECORD_BYTES) {
+        trace->error = TRACE_ERR_FORMAT;
+        return -1;
+    }
+
+    // records are little-endian (as are the hosts the native build targets)
+    unsigned int record[3];
+    memcpy(record, trace->data + trace->pos, TRACE_RECORD_BYTES);
+    trace->pos += TRACE_RECORD_BYTES;
+    for (int field = 0; field < 3; field++)
+        params[field] = record[field];
+    return 1;
+}
+
+int readTraceProcesses(TraceReader* trace, ProcessList* procList, unsigned int maxCount) {
+
+    if (trace->error != TRACE_OK) return -1;
+
+    // parse up to maxCount records
+    unsigned long long params[3];
+    unsigned int numRead = 0;
+    while (numRead < maxCount) {
+        int status = trace->format == TRACE_BINARY ? readBinaryRecord(trace, params) : parseCsvRecord(trace, params);
+        if (status < 0) return -1;
+        if (status == 0) break;
+
+        // track start time order (streaming needs it; a whole trace is sorted after reading)
+        if (trace->numRecords > 0 && params[1] < trace->lastStartTime) trace->isSorted = 0;
+        trace->lastStartTime = params[1];
+        trace->numRecords++;
+
+        // add process
+        if (addProcessBack(procList, (Process){ .pid = params[0], .startTime = params[1], .duration = params[2], .remainingTime = params[2], .rrTime = 0 }) == NULL) {
+            trace->error = TRACE_ERR_MEMORY;
+            return -1;
+        }
+        numRead++;
+    }
+
+    releaseParsedPages(trace);
+    return numRead;
+}
+
+// reads arrivals in chunks until one starts after 'time' (see ReadArrivals in procmgr.h)
+int readTraceArrivals(void* arrivalSource, ProcessList* unstarted, unsigned long long time) {
+
+    TraceReader* trace = arrivalSource;
+    while (unstarted->tail == NULL || unstarted->tail->process.startTime <= time) {
+        int numRead = readTraceProcesses(trace, unstarted, TRACE_CHUNK_PROCESSES);
+        if (numRead < 0) return -1;
+        if (!trace->isSorted) {
+            trace->error = TRACE_ERR_UNSORTED;
+            return -1;
+        }
+        if (numRead == 0) return 1;
+    }
+    return 0;
+}
+
+// returns a message for the reader's error
+const char* getTraceError(TraceReader* trace) {
+
+    switch (trace->error) {
+        case TRACE_OK:
+            return "no error";
+        case TRACE_ERR_OPEN:
+            return "could not open trace";
+        case TRACE_ERR_FORMAT:
+            return trace->format == TRACE_CSV ? "malformed record (expected 'pid,start,duration' per line)" : "truncated record";
+        case TRACE_ERR_RANGE:
+            return "number over the 32-bit limit";
+        case TRACE_ERR_UNSORTED:
+            return "start times are not in order (sort the trace or read it whole)";
+        case TRACE_ERR_MEMORY:
+            return "out of memory";
+    }
+    return "unknown error";
+}
+
+void closeTrace(TraceReader* trace) {
+
+    if (trace == NULL) return;
+    if (trace->data != NULL) munmap((void*)trace->data, trace->size);
+    free(trace);
+}
@@ -0,0 +1,62 @@
+// This header file represents a workload trace read straight from a memory-mapped file (native builds only).
+// Traces sorted by start time are parsed in chunks as the simulation reaches them, so multi-GB traces run in memory bounded by the processes alive at once.
+
+#ifndef PROCTRACE_H
+#define PROCTRACE_H
+
+#include <stddef.h>
+#include "proclist.h"
+
+// binary traces start with this 8 byte magic, followed by (pid, start, duration) records of 3 little-endian 32-bit words
+// CSV traces hold one 'pid,start,duration' record per line (a first line that does not start with a digit is a header)
+#define TRACE_MAGIC "SPMTRACE"
+#define TRACE_MAGIC_LEN 8
+#define TRACE_RECORD_BYTES 12
+
+// processes parsed per read while streaming
+#define TRACE_CHUNK_PROCESSES 4096
+
+// parsed pages are handed back to the kernel in steps of this many bytes
+#define TRACE_RELEASE_BYTES (64 * 1024 * 1024)
+
+enum TraceFormats {
+    TRACE_CSV,
+    TRACE_BINARY
+};
+
+// trace errors (TRACE_OK while reading is fine)
+enum TraceErrors {
+    TRACE_OK,
+    TRACE_ERR_OPEN,     // file could not be opened or mapped (see errno)
+    TRACE_ERR_FORMAT,   // malformed record (or truncated binary trace)
+    TRACE_ERR_RANGE,    // number over MAX_TIME_AND_PID
+    TRACE_ERR_UNSORTED, // start time before the previous record's (streaming needs start time order)
+    TRACE_ERR_MEMORY
+};
+
+// trace reader (the file stays mapped until it is closed)
+typedef struct TraceReader {
+
+    const char* data;
+    size_t size;
+    size_t pos;          // next byte to parse
+    size_t releasedPos;  // bytes before this were released
+    enum TraceFormats format;
+
+    unsigned long long numRecords;   // records read so far
+    unsigned long long lineNumber;   // CSV line of the next record (for errors)
+    unsigned int lastStartTime;      // start time of the last record read
+    char isSorted;                   // 1 while every record started no earlier than the one before
+    enum TraceErrors error;
+
+} TraceReader;
+
+TraceReader* openTrace(const char* path); // detects the format; returns null if the file cannot be opened or mapped
+
+int readTraceProcesses(TraceReader* trace, ProcessList* procList, unsigned int maxCount); // appends up to maxCount processes; returns the number read or -1 on error
+int readTraceArrivals(void* trace, ProcessList* unstarted, unsigned long long time); // arrival source for streamed runs (see procmgr.h)
+const char* getTraceError(TraceReader* trace);
+
+void closeTrace(TraceReader* trace);
+
+#endif
@@ -0,0 +1,26 @@
+// This header file defines the limits shared by the engine, the dashboard and the API.
+// build.sh generates the JS module (public/scripts/limits.mjs) from the MAX_ / NUM_ / SPM_ defines below, so keep them as plain integers.
+
+#ifndef SPMLIMITS_H
+#define SPMLIMITS_H
+
+#define MAX_NUM_CPUS 4096
+#define MAX_TIME_AND_PID 4294967295 // pids, start times, durations and quanta are 32-bit
+#define MAX_PROCESSES 16777216
+#define NUM_ALGS 7
+#define NUM_QUANTUM_ALGS 2 // algorithms that take a quantum (round robin and MLFQ), which sweeps run for every quantum in range
+
+// frame output grows geometrically up to this many bytes (text or binary)
+#define MAX_FRAME_DATA_BYTES 1073741824
+
+// parameter sweeps run at most this many configurations on at most this many threads
+#define MAX_SWEEP_CONFIGS 65536
+#define MAX_SWEEP_THREADS 64
+
+// live submission rings hold at most this many entries (12 bytes each, so the slots stay well inside a 32-bit address space)
+#define MAX_RING_CAPACITY 16777216
+
+// engine output version; bump it whenever the same input may give different output, since the dashboard's persistent run cache keys include it
+#define SPM_OUTPUT_VERSION 1
+
+#endif
@@ -0,0 +1,36 @@
+// This header file defines compile-time logging for the engine.
+// Messages above SPM_LOG_LEVEL are compiled out entirely, so the simulation loop does no I/O (in the browser, stderr goes through Emscripten's console shim).
+
+#ifndef SPMLOG_H
+#define SPMLOG_H
+
+#include <stdio.h>
+
+// levels: 0 = silent, 1 = errors (default), 2 = info (parsed input), 3 = trace (every process and frame)
+#define SPM_LOG_ERRORS 1
+#define SPM_LOG_INFO 2
+#define SPM_LOG_TRACE 3
+
+#ifndef SPM_LOG_LEVEL
+#define SPM_LOG_LEVEL SPM_LOG_ERRORS
+#endif
+
+#if SPM_LOG_LEVEL >= SPM_LOG_ERRORS
+#define LOG_ERROR(...) fprintf(stderr, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if SPM_LOG_LEVEL >= SPM_LOG_INFO
+#define LOG_INFO(...) fprintf(stderr, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if SPM_LOG_LEVEL >= SPM_LOG_TRACE
+#define LOG_TRACE(...) fprintf(stderr, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#endif
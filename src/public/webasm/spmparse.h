@@ -0,0 +1,64 @@
+// This header file defines the engine's decimal number parser.
+// Digits are classified and converted eight bytes at a time inside a 64-bit word (SWAR), so most numbers take one load instead of one branch per byte.
+
+#ifndef SPMPARSE_H
+#define SPMPARSE_H
+
+#include <stddef.h>
+#include <string.h>
+#include "spmlimits.h"
+
+// returns the number of leading digits in a little-endian word of 8 characters (8 if all are digits)
+static inline unsigned int countWordDigits(unsigned long long word) {
+
+    // subtract '0' from every byte; a byte is a digit if that is at most 9, i.e. neither it nor it + 0x76 has its high bit set
+    unsigned long long digits = word - 0x3030303030303030ull;
+    unsigned long long nonDigits = (digits | (digits + 0x7676767676767676ull)) & 0x8080808080808080ull;
+    return nonDigits == 0 ? 8 : __builtin_ctzll(nonDigits) / 8;
+}
+
+// converts the first 'numDigits' (1 to 8) characters of a little-endian word to their value
+static inline unsigned long long convertWordDigits(unsigned long long word, unsigned int numDigits) {
+
+    // move the digits to the top (the bytes shifted in become leading zeros), then combine pairs, quads and octets
+    unsigned long long digits = (word - 0x3030303030303030ull) << (8 * (8 - numDigits));
+    digits = (digits * 10 + (digits >> 8)) & 0x00FF00FF00FF00FFull;
+    digits = (digits * 100 + (digits >> 16)) & 0x0000FFFF0000FFFFull;
+    return (digits * 10000 + (digits >> 32)) & 0xFFFFFFFFull;
+}
+
+// parses the unsigned decimal at 'str', reading at most 'len' bytes; returns the number of digits (0 if there are none)
+// values over MAX_TIME_AND_PID are reported as MAX_TIME_AND_PID + 1 (however many digits follow)
+static inline size_t parseDecimal(const char* str, size_t len, unsigned long long* value) {
+
+    // one word at a time while 8 bytes are readable
+    unsigned long long result = 0;
+    size_t numDigits = 0;
+    while (numDigits + 8 <= len) {
+        unsigned long long word;
+        memcpy(&word, str + numDigits, sizeof(word));
+        unsigned int wordDigits = countWordDigits(word);
+        if (wordDigits == 0) break;
+        unsigned long long wordValue = convertWordDigits(word, wordDigits);
+        unsigned long long scale = 1;
+        for (unsigned int i = 0; i < wordDigits; i++)
+            scale *= 10;
+        result = result * scale + wordValue;
+        if (result > MAX_TIME_AND_PID) result = MAX_TIME_AND_PID + 1ull;
+        numDigits += wordDigits;
+        if (wordDigits < 8) {
+            *value = result;
+            return numDigits;
+        }
+    }
+
+    // remaining bytes (end of input)
+    while (numDigits < len && str[numDigits] >= '0' && str[numDigits] <= '9') {
+        result = result * 10 + (str[numDigits++] - '0');
+        if (result > MAX_TIME_AND_PID) result = MAX_TIME_AND_PID + 1ull;
+    }
+    *value = result;
+    return numDigits;
+}
+
+#endif
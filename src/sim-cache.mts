@@ -0,0 +1,105 @@
+import { createHash } from 'node:crypto';
+import { SimFormat, SimResult } from './sim-pool.mjs';
+
+// cached result with its size in bytes
+interface CacheEntry {
+    result: SimResult;
+    bytes: number;
+}
+
+export class SimCache {
+
+    private _maxBytes: number;
+    private _bytes: number = 0;
+    private _entries: Map<string, CacheEntry> = new Map(); // oldest use first (a hit moves its entry to the end)
+    private _running: Map<string, Promise<SimResult>> = new Map();
+    private _processStr: string | undefined = undefined;
+    private _processVersion: number = 0;
+
+    // results are kept until they exceed maxBytes in total (256 MiB by default)
+    constructor(maxBytes: number = 256 * 1024 * 1024) {
+        this._maxBytes = maxBytes;
+    }
+
+    /**
+     * Hashes an engine input into a cache key.
+     * @param {SimFormat} format The result format.
+     * @param {string} paramStr The engine input (settings and the process set in pid order).
+     * @returns {string} The hex SHA-256 digest.
+     */
+    public static getKey(format: SimFormat, paramStr: string): string {
+        return createHash('sha256').update(format).update(',').update(paramStr).digest('hex');
+    }
+
+    /**
+     * Returns a cached result, or runs and caches it (identical concurrent runs share one simulation).
+     * @param {string} key The result's cache key.
+     * @param {() => Promise<SimResult>} run Runs the simulation on a miss.
+     * @returns {Promise<SimResult>} The cached or new result.
+     */
+    public getOrRun(key: string, run: () => Promise<SimResult>): Promise<SimResult> {
+
+        // hit: mark as most recently used
+        const entry = this._entries.get(key);
+        if (entry !== undefined) {
+            this._entries.delete(key);
+            this._entries.set(key, entry);
+            return Promise.resolve(entry.result);
+        }
+
+        // miss: join a running simulation of the same input, or start one
+        let pending = this._running.get(key);
+        if (pending === undefined) {
+            pending = run()
+                .then(result => {
+                    this._add(key, result);
+                    return result;
+                })
+                .finally(() => this._running.delete(key));
+            this._running.set(key, pending);
+        }
+        return pending;
+    }
+
+    // the canonical process set (engine input in pid order) while the spm collection is unchanged
+    public get processStr(): string | undefined {
+        return this._processStr;
+    }
+
+    // changes on every invalidation, so reads that raced a change are not cached
+    public get processVersion(): number {
+        return this._processVersion;
+    }
+
+    /**
+     * Caches the process set read from the spm collection.
+     * @param {string} processStr The process set in engine format.
+     * @param {number} version The process version from before the read started.
+     */
+    public setProcessStr(processStr: string, version: number) {
+        if (version === this._processVersion)
+            this._processStr = processStr;
+    }
+
+    // drops the cached process set after the spm collection changed
+    // results stay, since their keys hash the process set (an edit that is undone hits them again)
+    public invalidateProcesses() {
+        this._processStr = undefined;
+        this._processVersion++;
+    }
+
+    // adds a result, evicting the least recently used ones past the byte budget
+    private _add(key: string, result: SimResult) {
+
+        const bytes = key.length + (result.frames?.byteLength ?? 0) + (result.intervals?.byteLength ?? 0) + (result.metrics?.length ?? 0) * 8;
+        if (bytes > this._maxBytes) return;
+
+        this._entries.set(key, { result, bytes });
+        this._bytes += bytes;
+        for (const [oldKey, oldEntry] of this._entries) {
+            if (this._bytes <= this._maxBytes) break;
+            this._entries.delete(oldKey);
+            this._bytes -= oldEntry.bytes;
+        }
+    }
+}
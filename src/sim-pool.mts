@@ -0,0 +1,143 @@
+import os from 'node:os';
+import { Worker } from 'node:worker_threads';
+
+export type SimFormat = 'metrics' | 'frames' | 'intervals';
+
+// job handed to a simulation worker (param string uses the engine format 'numCpus,alg,quantum,pid,start,duration,...')
+export interface SimJob {
+    id: number;
+    paramStr: string;
+    format: SimFormat;
+}
+
+// worker reply (metrics in SimMetrics field order, the raw frame words of a FrameBuffer, or the interval words of an IntervalBuffer followed by its queue point words)
+export interface SimResult {
+    id: number;
+    error?: string;
+    errorCode?: number;
+    metrics?: number[];
+    frames?: ArrayBuffer;
+    stride?: number;
+    numFrames?: number;
+    intervals?: ArrayBuffer;
+    numIntervals?: number;
+    numQueuePoints?: number;
+}
+
+// thrown when every worker is busy and the wait queue is full (the API answers 503)
+export class SimPoolBusyError extends Error {
+    constructor() {
+        super('Simulation server is busy, try again later');
+    }
+}
+
+// engine error for a run whose output or simulated time is over its limit (see SpmErrors in procmgr.h)
+const SPM_ERR_LIMIT = 5;
+
+// thrown when a simulation's output or simulated time is over the engine's limits (the API answers 413)
+export class SimLimitError extends Error {
+    constructor() {
+        super('Simulation is too large - its frames would pass the output limit or its time the 32-bit limit (request metrics instead)');
+    }
+}
+
+// time histogram summary and metric names in SimMetrics field order (see procstats.h)
+const SUMMARY_NAMES = ['avg', 'p50', 'p90', 'p99', 'max'] as const;
+const METRIC_NAMES = ['num_processes', 'makespan', 'busy_time', 'cpu_utilization', 'throughput', 'context_switches', 'preemptions'] as const;
+const SUMMARY_METRIC_NAMES = ['waiting_time', 'turnaround_time', 'response_time'] as const;
+export const SIM_METRICS_LENGTH = METRIC_NAMES.length + SUMMARY_METRIC_NAMES.length * SUMMARY_NAMES.length;
+
+/**
+ * Converts metrics in SimMetrics field order to a JSON friendly object.
+ * @param {number[]} values The metric values.
+ * @returns {Record<string, number | Record<string, number>>} The named metrics.
+ */
+export function toMetricsObject(values: number[]): Record<string, number | Record<string, number>> {
+    let metrics: Record<string, number | Record<string, number>> = {};
+    METRIC_NAMES.forEach((name, i) => metrics[name] = values[i]);
+    SUMMARY_METRIC_NAMES.forEach((name, i) => {
+        const offset = METRIC_NAMES.length + i * SUMMARY_NAMES.length;
+        metrics[name] = Object.fromEntries(SUMMARY_NAMES.map((summaryName, j) => [summaryName, values[offset + j]]));
+    });
+    return metrics;
+}
+
+// queued or running job with its promise callbacks
+interface PendingJob {
+    job: SimJob;
+    resolve: (result: SimResult) => void;
+    reject: (err: Error) => void;
+}
+
+export class SimPool {
+
+    private _maxWorkers: number;
+    private _maxQueued: number;
+    private _nextId: number = 0;
+    private _idle: Worker[] = [];
+    private _running: Map<Worker, PendingJob> = new Map();
+    private _queue: PendingJob[] = [];
+
+    // workers are started on demand, up to one per core by default; at most maxQueued jobs wait for one
+    constructor(maxWorkers: number = os.availableParallelism(), maxQueued: number = maxWorkers * 16) {
+        this._maxWorkers = Math.max(1, maxWorkers);
+        this._maxQueued = maxQueued;
+    }
+
+    /**
+     * Runs a simulation on the next free worker.
+     * @param {string} paramStr The engine input ('numCpus,alg,quantum,pid,start,duration,...').
+     * @param {SimFormat} format Whether to return metrics, binary frames or binary intervals.
+     * @returns {Promise<SimResult>} The worker's result (rejects with SimPoolBusyError if the queue is full).
+     */
+    public run(paramStr: string, format: SimFormat): Promise<SimResult> {
+        return new Promise((resolve, reject) => {
+
+            // refuse once the queue is full (bounded memory under load)
+            if (this._queue.length >= this._maxQueued) {
+                reject(new SimPoolBusyError());
+                return;
+            }
+
+            // queue job and start it if a worker is free (or can be started)
+            this._queue.push({ job: { id: this._nextId++, paramStr, format }, resolve, reject });
+            this._dispatch();
+        });
+    }
+
+    // hands queued jobs to idle workers, starting new workers up to the limit
+    private _dispatch() {
+        while (this._queue.length > 0) {
+            let worker = this._idle.pop();
+            if (worker === undefined && this._idle.length + this._running.size < this._maxWorkers)
+                worker = this._startWorker();
+            if (worker === undefined) return;
+            const pending = this._queue.shift() as PendingJob;
+            this._running.set(worker, pending);
+            worker.postMessage(pending.job);
+        }
+    }
+
+    // starts a worker; a worker that dies fails its job and is replaced on the next dispatch
+    private _startWorker(): Worker {
+        const worker = new Worker(new URL('./sim-worker.mjs', import.meta.url));
+        worker.on('message', (result: SimResult) => {
+            const pending = this._running.get(worker);
+            this._running.delete(worker);
+            this._idle.push(worker);
+            if (pending !== undefined) {
+                if (result.error !== undefined) pending.reject(result.errorCode === SPM_ERR_LIMIT ? new SimLimitError() : new Error(result.error));
+                else pending.resolve(result);
+            }
+            this._dispatch();
+        });
+        worker.on('error', err => {
+            const pending = this._running.get(worker);
+            this._running.delete(worker);
+            this._idle = this._idle.filter(idleWorker => idleWorker !== worker);
+            pending?.reject(err);
+            this._dispatch();
+        });
+        return worker;
+    }
+}
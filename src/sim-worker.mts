@@ -0,0 +1,65 @@
+import { parentPort } from 'node:worker_threads';
+import { SIM_METRICS_LENGTH, SimJob, SimResult } from './sim-pool.mjs';
+
+// each worker owns one instance of the engine's node build (see build.sh), so simulations never share memory
+const { default: createEngineModule } = await import(new URL('./webasm/procnode.mjs', import.meta.url).href);
+const engine = await createEngineModule();
+
+// FrameBuffer header words (data pointer, size, capacity, stride, numFrames; see framebuf.h)
+const FRAME_BUFFER_WORDS = 5;
+
+// IntervalBuffer header words (data pointer, numIntervals, queue points pointer, numQueuePoints, numCpus, numFrames; see intervalbuf.h)
+const INTERVAL_BUFFER_WORDS = 6;
+const INTERVAL_WORDS = 5;
+const QUEUE_POINT_WORDS = 2;
+
+// reply for a failed job (the engine error says why; see SpmErrors in procmgr.h)
+function failJob(id: number): [SimResult, ArrayBuffer[]] {
+    const errorCode = engine._spmGetError();
+    return [{ id, error: `Could not run simulation (engine error ${errorCode})`, errorCode }, []];
+}
+
+// runs one job; frame and interval words are copied out of WASM memory and transferred, not cloned
+function runJob(job: SimJob): [SimResult, ArrayBuffer[]] {
+
+    const cParamStr = engine.stringToNewUTF8(job.paramStr);
+    try {
+
+        // metrics (SimMetrics is all doubles)
+        if (job.format === 'metrics') {
+            const metricsPtr = engine._getMetrics(cParamStr);
+            if (metricsPtr === 0) return failJob(job.id);
+            const metrics = Array.from(engine.HEAPF64.subarray(metricsPtr >> 3, (metricsPtr >> 3) + SIM_METRICS_LENGTH) as Float64Array);
+            engine._free(metricsPtr);
+            return [{ id: job.id, metrics }, []];
+        }
+
+        // binary intervals (queue points follow the intervals in one buffer)
+        if (job.format === 'intervals') {
+            const intervalsPtr = engine._getIntervalData(cParamStr);
+            if (intervalsPtr === 0) return failJob(job.id);
+            const [dataPtr, numIntervals, queuePtr, numQueuePoints, , numFrames] = engine.HEAPU32.subarray(intervalsPtr >> 2, (intervalsPtr >> 2) + INTERVAL_BUFFER_WORDS) as Uint32Array;
+            const words = new Uint32Array(numIntervals * INTERVAL_WORDS + numQueuePoints * QUEUE_POINT_WORDS);
+            words.set(engine.HEAPU32.subarray(dataPtr >> 2, (dataPtr >> 2) + numIntervals * INTERVAL_WORDS));
+            words.set(engine.HEAPU32.subarray(queuePtr >> 2, (queuePtr >> 2) + numQueuePoints * QUEUE_POINT_WORDS), numIntervals * INTERVAL_WORDS);
+            engine._freeIntervalData(intervalsPtr);
+            return [{ id: job.id, intervals: words.buffer, numIntervals, numQueuePoints, numFrames }, [words.buffer]];
+        }
+
+        // binary frames
+        const frameBufPtr = engine._getFrameData(cParamStr);
+        if (frameBufPtr === 0) return failJob(job.id);
+        const [dataPtr, size, , stride, numFrames] = engine.HEAPU32.subarray(frameBufPtr >> 2, (frameBufPtr >> 2) + FRAME_BUFFER_WORDS) as Uint32Array;
+        const frames = (engine.HEAPU32.slice(dataPtr >> 2, (dataPtr >> 2) + size) as Uint32Array).buffer;
+        engine._freeFrameData(frameBufPtr);
+        return [{ id: job.id, frames, stride, numFrames }, [frames]];
+
+    } finally {
+        engine._free(cParamStr);
+    }
+}
+
+parentPort?.on('message', (job: SimJob) => {
+    const [result, transfer] = runJob(job);
+    parentPort?.postMessage(result, transfer);
+});